@@ -0,0 +1,50 @@
+#include "AllocCounter.h"
+
+#ifdef COUNT_ALLOCS
+
+#include <cstdlib>
+#include <new>
+
+static thread_local long long t_count = 0;
+static thread_local int t_paused = 0;
+
+long long AllocCounter::count()
+{
+    return t_count;
+}
+
+void AllocCounter::pause()
+{
+    t_paused++;
+}
+
+void AllocCounter::resume()
+{
+    t_paused--;
+}
+
+// ===== GLOBAL OPERATOR NEW/DELETE =====
+// The sized, array and nothrow forms all end up in these two by default.
+
+void* operator new(std::size_t size)
+{
+    if (t_paused == 0) {
+        t_count++;
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+#endif
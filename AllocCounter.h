@@ -0,0 +1,39 @@
+#pragma once
+
+// Heap allocation counter for checking that the turn loop does not allocate.
+//
+// Only active in binaries built with -DCOUNT_ALLOCS (make RobotWarz_allocs),
+// where AllocCounter.cpp replaces the global operator new. Counts are per
+// thread. Calls into robot code are wrapped in a Pause so allocations a robot
+// makes for itself are not charged to the arena.
+class AllocCounter {
+public:
+#ifdef COUNT_ALLOCS
+    static long long count();
+    static void pause();
+    static void resume();
+#else
+    static long long count() { return 0; }
+    static void pause() {}
+    static void resume() {}
+#endif
+
+    static bool enabled()
+    {
+#ifdef COUNT_ALLOCS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Stops counting on this thread for as long as it is in scope
+    class Pause {
+    public:
+        Pause() { AllocCounter::pause(); }
+        ~Pause() { AllocCounter::resume(); }
+
+        Pause(const Pause&) = delete;
+        Pause& operator=(const Pause&) = delete;
+    };
+};
@@ -1,56 +1,110 @@
 #include "Arena.h"
+#include "AllocCounter.h"
+#include "ArenaProfile.h"
 #include <iostream>
 #include <iomanip>
 #include <filesystem>
 #include <dlfcn.h>
 #include <cstdlib>
 #include <algorithm>
-#include <random>
+#include <array>
 
 namespace fs = std::filesystem;
 
+// Obstacles place_obstacles() puts down on average at scale 1 (6.5 + 5.5 + 8)
+static constexpr double MEAN_OBSTACLES = 20.0;
+
 // ===== CONSTRUCTOR/DESTRUCTOR =====
 
-Arena::Arena(int rows, int cols) 
-    : m_rows(rows), m_cols(cols), m_round(0), m_alive_count(0), m_max_rounds(1000) 
+template <typename BoardType>
+BasicArena<BoardType>::BasicArena(int rows, int cols) 
+    : m_rows(rows), m_cols(cols), m_board(rows, cols), m_round(0), m_alive_count(0), m_max_rounds(1000), m_headless(false), 
+      m_namespace(LM_ID_BASE), m_steady_allocs(0), m_copies(1), m_obstacle_scale(1.0) 
 {
-    // Initialize board with empty cells
-    m_board.resize(m_rows, std::vector<char>(m_cols, EMPTY));
+    // Room for everything the longest ray can see
+    m_radar_results.reserve(m_board.max_radar_cells());
 }
 
-Arena::~Arena() 
+template <typename BoardType>
+BasicArena<BoardType>::~BasicArena() 
 {
     unload_robots();
 }
 
+template <typename BoardType>
+void BasicArena<BoardType>::set_headless(bool headless) 
+{
+    m_headless = headless;
+}
+
+template <typename BoardType>
+bool BasicArena<BoardType>::is_headless() const 
+{
+    return m_headless;
+}
+
+template <typename BoardType>
+void BasicArena<BoardType>::set_link_namespace(Lmid_t lmid) 
+{
+    m_namespace = lmid;
+}
+
+template <typename BoardType>
+void BasicArena<BoardType>::set_copies_per_robot(int copies) 
+{
+    m_copies = std::max(copies, 1);
+}
+
+template <typename BoardType>
+void BasicArena<BoardType>::set_obstacle_density(double density) 
+{
+    // Scale the standard counts so that on average they cover this fraction of the field
+    m_obstacle_scale = std::max(density, 0.0) * m_rows * m_cols / MEAN_OBSTACLES;
+}
+
+template <typename BoardType>
+void BasicArena<BoardType>::set_seed(uint64_t seed, uint64_t game) 
+{
+    m_rng.reseed(seed, game);
+}
+
 // ===== ROBOT LOADING =====
 
-bool Arena::load_robots(const std::string& directory) 
+template <typename BoardType>
+bool BasicArena<BoardType>::load_robots(const std::string& directory, int jobs, BuildProfile profile) 
 {
-    std::cout << "\nLoading Robots...\n";
+    if (!m_headless) {
+        std::cout << "\nLoading Robots...\n";
+    }
     
-    // Find all Robot_*.cpp files
-    for (const auto& entry : fs::directory_iterator(directory)) {
-        std::string filename = entry.path().filename().string();
-        
-        // Check if it matches Robot_*.cpp pattern
-        if (filename.find("Robot_") == 0 && filename.ends_with(".cpp")) {
-            
-            // Compile the robot
-            if (!compile_robot(filename)) {
-                std::cerr << "Failed to compile " << filename << std::endl;
-                continue;
-            }
-            
-            // Extract robot name (remove Robot_ prefix and .cpp suffix)
-            std::string robot_name = filename.substr(6, filename.length() - 10);
-            std::string so_filename = "lib" + robot_name + ".so";
+    // Compile all Robot_*.cpp files (unchanged robots come straight from the cache)
+    RobotCompiler compiler(directory);
+    compiler.set_verbose(!m_headless);
+    compiler.set_profile(profile);
+    if (jobs > 0) {
+        compiler.set_jobs(jobs);
+    }
+    std::vector<std::string> built;
+    {
+        ArenaProfile::Scope timer(m_profile, PROFILE_COMPILE);
+        built = compiler.build(RobotCompiler::find_sources(directory));
+    }
+    
+    // With several copies per robot, the plugins take turns so each copy
+    // round gets one of each; every copy is a separate factory call
+    for (int copy = 0; copy < m_copies; copy++) {
+        for (size_t library = 0; library < built.size(); library++) {
+            std::string robot_name = RobotCompiler::robot_name(built[library]);
+            std::string so_path = compiler.library_path(built[library]);
             
             // Load the compiled library
-            if (!load_robot_library(so_filename, robot_name)) {
-                std::cerr << "Failed to load " << so_filename << std::endl;
+            if (!load_robot_library(so_path, robot_name, library)) {
+                std::cerr << "Failed to load " << so_path << std::endl;
                 continue;
             }
+            if (copy > 0) {
+                name_robot(m_robots.size() - 1, robot_name + "#" + std::to_string(copy + 1));
+            }
         }
     }
     
@@ -58,26 +112,16 @@ bool Arena::load_robots(const std::string& directory)
     return m_robots.size() > 0;
 }
 
-bool Arena::compile_robot(const std::string& cpp_filename) 
+template <typename BoardType>
+bool BasicArena<BoardType>::load_robot_library(const std::string& so_path, const std::string& robot_name, int library) 
 {
-    // Extract robot name
-    std::string robot_name = cpp_filename.substr(6, cpp_filename.length() - 10);
-    std::string so_filename = "lib" + robot_name + ".so";
-    
-    std::cout << "Compiling " << cpp_filename << " to " << so_filename << "...\n";
+    ArenaProfile::Scope timer(m_profile, PROFILE_DLOPEN);
     
-    // Build compilation command
-    std::string compile_cmd = "g++ -shared -fPIC -o " + so_filename + 
-                             " " + cpp_filename + " RobotBase.cpp -std=c++17";
-    
-    int result = system(compile_cmd.c_str());
-    return result == 0;
-}
-
-bool Arena::load_robot_library(const std::string& so_filename, const std::string& robot_name) 
-{
-    // Open the shared library
-    void* lib_handle = dlopen(("./" + so_filename).c_str(), RTLD_NOW);
+    // Open the shared library, in the arena's private namespace if it has one
+    std::string path = (so_path.find('/') == std::string::npos) ? "./" + so_path : so_path;
+    void* lib_handle = (m_namespace == LM_ID_BASE)
+        ? dlopen(path.c_str(), RTLD_NOW)
+        : dlmopen(m_namespace, path.c_str(), RTLD_NOW | RTLD_LOCAL);
     if (!lib_handle) {
         std::cerr << "dlopen error: " << dlerror() << std::endl;
         return false;
@@ -93,302 +137,379 @@ bool Arena::load_robot_library(const std::string& so_filename, const std::string
         return false;
     }
     
+    // add_robot takes ownership of the library handle
+    return add_robot(factory, robot_name, lib_handle, library);
+}
+
+template <typename BoardType>
+bool BasicArena<BoardType>::add_robot(RobotFactory factory, const std::string& robot_name, void* lib_handle, int library) 
+{
     // Create the robot using the factory
     RobotBase* robot = factory();
     if (!robot) {
         std::cerr << "Factory failed to create robot\n";
-        dlclose(lib_handle);
+        if (lib_handle) {
+            dlclose(lib_handle);
+        }
         return false;
     }
     
     // Set robot properties
-    robot->m_name = robot_name;
     robot->set_boundaries(m_rows, m_cols);
     
-    // Assign a unique symbol
-    if (m_robots.size() < ROBOT_SYMBOLS.length()) {
-        robot->m_character = ROBOT_SYMBOLS[m_robots.size()];
+    // Robots are identified by index (the board's robot-id grid), which caps a
+    // game at what a uint16_t id can hold
+    if (m_robots.size() >= MAX_ROBOTS) {
+        std::cerr << "Too many robots (at most " << MAX_ROBOTS << " per game)\n";
+        delete robot;
+        if (lib_handle) {
+            dlclose(lib_handle);
+        }
+        return false;
     }
     
+    // The symbol is only for display and radar; past the end of the list they repeat
+    robot->m_character = ROBOT_SYMBOLS[m_robots.size() % ROBOT_SYMBOLS.length()];
+    
     // Store robot info
     RobotInfo info;
     info.robot.reset(robot);
+    info.library = library;
     info.lib_handle = lib_handle;
-    info.is_alive = true;
-    info.in_pit = false;
+    info.move_speed = robot->get_move_speed();
     
     int robot_index = m_robots.size();
     m_robots.push_back(std::move(info));
-    m_robot_symbol_to_index[robot->m_character] = robot_index;
+    m_state.push_back(*robot);
+    name_robot(robot_index, robot_name);
+    m_alive_count = m_robots.size();
     
     // Place robot on board
-    std::cout << "boundaries: " << m_rows << ", " << m_cols << std::endl;
+    if (!m_headless) {
+        std::cout << "boundaries: " << m_rows << ", " << m_cols << std::endl;
+    }
     if (!place_robot(robot_index)) {
+        // Board is full: drop the robot again rather than leave it off the board
         std::cerr << "Failed to place robot on board\n";
+        m_robots.back().robot.reset();
+        if (lib_handle) {
+            dlclose(lib_handle);
+        }
+        m_robots.pop_back();
+        m_state.pop_back();
+        m_alive_count = m_robots.size();
         return false;
     }
     
-    int row, col;
-    robot->get_current_location(row, col);
-    std::cout << "Loaded robot: " << robot_name << " at (" << row << ", " << col << ")\n";
+    if (!m_headless) {
+        std::cout << "Loaded robot: " << robot_name << " at (" << m_state.row[robot_index] << ", "
+                  << m_state.col[robot_index] << ")\n";
+    }
     
     return true;
 }
 
+// The arena keeps the display name; the robot's own m_name is only ever
+// assigned by code in the robot's namespace. A std::string written here with
+// the arena's allocator would be freed by a dlmopen'ed robot's own libc.
+template <typename BoardType>
+void BasicArena<BoardType>::name_robot(int robot_index, const std::string& name) 
+{
+    RobotInfo& info = m_robots[robot_index];
+    info.name = name;
+    
+    RobotNameSetter set_name = nullptr;
+    if (info.lib_handle) {
+        set_name = (RobotNameSetter)dlsym(info.lib_handle, "set_robot_name");
+    }
+    if (set_name) {
+        set_name(info.robot.get(), name.c_str());
+    } else if (!info.lib_handle || m_namespace == LM_ID_BASE) {
+        info.robot->m_name = name;
+    }
+}
+
 // ===== GAME SETUP =====
 
-void Arena::initialize_board() 
+template <typename BoardType>
+void BasicArena<BoardType>::initialize_board() 
 {
     // Clear board
-    for (int r = 0; r < m_rows; r++) {
-        for (int c = 0; c < m_cols; c++) {
-            m_board[r][c] = EMPTY;
-        }
-    }
+    m_board.clear();
     
     // Place obstacles
     place_obstacles();
     
     // Place robots on board
     for (size_t i = 0; i < m_robots.size(); i++) {
-        if (m_robots[i].is_alive) {
-            int row, col;
-            m_robots[i].robot->get_current_location(row, col);
-            m_board[row][col] = m_robots[i].robot->m_character;
+        if (m_state.alive[i]) {
+            m_board.set_robot(m_state.row[i], m_state.col[i], m_robots[i].robot->m_character, i);
         }
     }
 }
 
-void Arena::place_obstacles() 
+template <typename BoardType>
+void BasicArena<BoardType>::place_obstacles() 
 {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> row_dist(0, m_rows - 1);
-    std::uniform_int_distribution<> col_dist(0, m_cols - 1);
+    // The counts below are for the default obstacle scale of 1
     
     // Place random flamethrowers (5-8 obstacles)
-    std::uniform_int_distribution<> flame_dist(5, 8);
-    int flame_count = flame_dist(gen);
+    int flame_count = (int)(m_rng.uniform(5, 8) * m_obstacle_scale);
     for (int i = 0; i < flame_count; i++) {
-        for (int attempt = 0; attempt < 20; attempt++) {
-            int r = row_dist(gen);
-            int c = col_dist(gen);
-            if (m_board[r][c] == EMPTY) {
-                m_board[r][c] = FLAMETHROWER;
-                break;
-            }
+        int r, c;
+        if (m_board.random_free_cell(m_rng, r, c)) {
+            place_obstacle(r, c, FLAMETHROWER);
         }
     }
     
     // Place random pits (4-7 obstacles)
-    std::uniform_int_distribution<> pit_dist(4, 7);
-    int pit_count = pit_dist(gen);
+    int pit_count = (int)(m_rng.uniform(4, 7) * m_obstacle_scale);
     for (int i = 0; i < pit_count; i++) {
-        for (int attempt = 0; attempt < 20; attempt++) {
-            int r = row_dist(gen);
-            int c = col_dist(gen);
-            if (m_board[r][c] == EMPTY) {
-                m_board[r][c] = PIT;
-                break;
-            }
+        int r, c;
+        if (m_board.random_free_cell(m_rng, r, c)) {
+            place_obstacle(r, c, PIT);
         }
     }
     
     // Place random mounds (6-10 obstacles - most common)
-    std::uniform_int_distribution<> mound_dist(6, 10);
-    int mound_count = mound_dist(gen);
+    int mound_count = (int)(m_rng.uniform(6, 10) * m_obstacle_scale);
     for (int i = 0; i < mound_count; i++) {
-        for (int attempt = 0; attempt < 20; attempt++) {
-            int r = row_dist(gen);
-            int c = col_dist(gen);
-            if (m_board[r][c] == EMPTY) {
-                m_board[r][c] = MOUND;
-                break;
-            }
+        int r, c;
+        if (m_board.random_free_cell(m_rng, r, c)) {
+            place_obstacle(r, c, MOUND);
         }
     }
 }
-bool Arena::place_robot(int robot_index) 
+
+template <typename BoardType>
+void BasicArena<BoardType>::place_obstacle(int row, int col, CellType obstacle) 
 {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> row_dist(0, m_rows - 1);
-    std::uniform_int_distribution<> col_dist(0, m_cols - 1);
-    
-    // Helper lambda to count open neighbors
-    auto count_open_neighbors = [this](int r, int c) -> int {
-        int count = 0;
-        for (int dr = -1; dr <= 1; dr++) {
-            for (int dc = -1; dc <= 1; dc++) {
-                if (dr == 0 && dc == 0) continue;
-                int nr = r + dr;
-                int nc = c + dc;
-                if (is_valid_position(nr, nc) && m_board[nr][nc] == EMPTY) {
-                    count++;
-                }
-            }
-        }
-        return count;
-    };
-    
-    // Try to find empty spot with at least 3 open neighbors (max 150 attempts)
-    for (int attempt = 0; attempt < 150; attempt++) {
-        int r = row_dist(gen);
-        int c = col_dist(gen);
-        
-        if (m_board[r][c] == EMPTY && count_open_neighbors(r, c) >= 3) {
-            m_robots[robot_index].robot->move_to(r, c);
-            m_board[r][c] = m_robots[robot_index].robot->m_character;
-            return true;
-        }
+    if (is_valid_position(row, col)) {
+        m_board.set(row, col, obstacle);
     }
-    
-    // Fallback: just find any empty spot
-    for (int attempt = 0; attempt < 50; attempt++) {
-        int r = row_dist(gen);
-        int c = col_dist(gen);
-        
-        if (m_board[r][c] == EMPTY) {
-            m_robots[robot_index].robot->move_to(r, c);
-            m_board[r][c] = m_robots[robot_index].robot->m_character;
-            return true;
-        }
+}
+
+template <typename BoardType>
+bool BasicArena<BoardType>::place_robot(int robot_index) 
+{
+    // An empty spot with at least 3 open neighbors, or failing that any empty spot
+    int r, c;
+    if (!m_board.random_roomy_cell(m_rng, r, c) && !m_board.random_free_cell(m_rng, r, c)) {
+        return false;  // Board is full
     }
     
-    return false;
+    set_robot_location(robot_index, r, c);
+    m_board.set_robot(r, c, m_robots[robot_index].robot->m_character, robot_index);
+    return true;
+}
+
+template <typename BoardType>
+void BasicArena<BoardType>::reserve_turn_buffers() 
+{
+    // A turn queues at most one hit per robot plus one from an obstacle
+    m_damage_events.reserve(m_robots.size() + 1);
+    m_board.reserve_for_robots(m_robots.size());
 }
 
 // ===== GAME LOOP =====
 
-void Arena::run_game() 
+template <typename BoardType>
+void BasicArena<BoardType>::play_game() 
 {
-    initialize_board();
+    start_game();
     
+    // Everything the arena needs is allocated by the end of round 1; from then
+    // on a round should not allocate at all (checked in COUNT_ALLOCS builds)
+    long long allocs_after_first_round = 0;
     while (!is_game_over()) {
-        run_round();
-        m_round++;
+        play_round();
+        if (m_round == 1) {
+            allocs_after_first_round = AllocCounter::count();
+        }
     }
+    m_steady_allocs = AllocCounter::count() - allocs_after_first_round;
+}
+
+template <typename BoardType>
+void BasicArena<BoardType>::start_game() 
+{
+    initialize_board();
+    reserve_turn_buffers();
+    m_profile.set_robot_count(m_robots.size());
+}
+
+template <typename BoardType>
+void BasicArena<BoardType>::play_round() 
+{
+    ArenaProfile::Scope timer(m_profile, PROFILE_ROUND);
+    run_round();
+    m_round++;
+}
+
+template <typename BoardType>
+void BasicArena<BoardType>::run_game() 
+{
+    play_game();
     
-    announce_winner();
+    if (m_headless) {
+        print_result();
+    } else {
+        announce_winner();
+    }
 }
 
-void Arena::run_round() 
+template <typename BoardType>
+void BasicArena<BoardType>::run_round() 
 {
-    // Always display every round
-    bool should_display = true;
+    // Headless rounds run the quiet turn pipeline, which has no output code at all
+    if (m_headless) {
+        for (size_t i = 0; i < m_robots.size(); i++) {
+            if (m_state.alive[i]) {
+                robot_turn<false>(i);
+            }
+        }
+        return;
+    }
     
-    if (should_display) {
-        std::cout << "\n=========== starting round " << m_round << " ===========\n";
+    // Display every round unless running headless
+    std::cout << "\n=========== starting round " << m_round << " ===========\n";
+    {
+        ArenaProfile::Scope timer(m_profile, PROFILE_RENDER);
         display_board();
-        
-        // Add a delay when displaying to make it readable
-        std::this_thread::sleep_for(std::chrono::milliseconds(1200));
     }
     
+    // Add a delay when displaying to make it readable
+    std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+    
     // Each alive robot takes a turn
     for (size_t i = 0; i < m_robots.size(); i++) {
-        if (m_robots[i].is_alive) {
-            robot_turn(i);
+        if (m_state.alive[i]) {
+            robot_turn<true>(i);
         }
     }
 }
 
-void Arena::robot_turn(int robot_index) 
+template <typename BoardType>
+template <bool Verbose>
+void BasicArena<BoardType>::robot_turn(int robot_index) 
 {
+    ArenaProfile::Scope timer(m_profile, PROFILE_TURN, robot_index);
     RobotInfo& info = m_robots[robot_index];
     
-    // Always display verbose output for every round
-    bool verbose = true;
-    
-    if (verbose) {
-        std::cout << "\n" << info.robot->m_name << " " << info.robot->m_character 
+    // Verbose output for every turn unless running headless
+    if constexpr (Verbose) {
+        std::cout << "\n" << info.name << " " << info.robot->m_character 
                   << " begins turn.\n";
         display_robot_info(robot_index);
     }
     
     // 1. Radar scan
-    handle_radar(robot_index, verbose);
+    handle_radar<Verbose>(robot_index);
     
     // 2. Movement (with pit escape after 5 turns)
-    if (!info.in_pit) {
-        handle_movement(robot_index, verbose);
+    if (!m_state.in_pit[robot_index]) {
+        handle_movement<Verbose>(robot_index);
     } else {
         // Robot is stuck in pit - try to escape after 5 consecutive turns
         info.pit_turns++;
         if (info.pit_turns >= 5) {
             // Try to escape by teleporting out of pit
-            handle_pit_escape(robot_index, verbose);
+            handle_pit_escape<Verbose>(robot_index);
             info.pit_turns = 0;  // Reset counter after escape attempt
-        } else if (verbose) {
-            std::cout << info.robot->m_name << " is stuck in a pit! (" 
+        } else if constexpr (Verbose) {
+            std::cout << info.name << " is stuck in a pit! (" 
                       << info.pit_turns << "/5 turns)\n";
         }
     }
     
     // 3. Shooting
-    handle_shooting(robot_index, verbose);
+    handle_shooting<Verbose>(robot_index);
+    
+    // 4. Everything that hit this turn (shots, obstacles) lands at once
+    ArenaProfile::Scope damage_timer(m_profile, PROFILE_DAMAGE, robot_index);
+    resolve_damage<Verbose>();
 }
 
 // ===== ROBOT ACTIONS =====
 
-void Arena::handle_radar(int robot_index, bool verbose) 
+template <typename BoardType>
+template <bool Verbose>
+void BasicArena<BoardType>::handle_radar(int robot_index) 
 {
+    ArenaProfile::Scope timer(m_profile, PROFILE_RADAR, robot_index);
     RobotBase* robot = m_robots[robot_index].robot.get();
+    int row = m_state.row[robot_index];
+    int col = m_state.col[robot_index];
     
-    // Get robot location
-    int row, col;
-    robot->get_current_location(row, col);
+    // Scan the direction the robot asked for (0 = the 8 surrounding cells)
+    int direction = 0;
+    {
+        AllocCounter::Pause robot_code;
+        ArenaProfile::Scope callback(m_profile, PROFILE_GET_RADAR_DIRECTION, robot_index);
+        robot->get_radar_direction(direction);
+    }
     
-    // Scan in all 8 directions (360-degree radar sweep)
-    std::vector<RadarObj> all_results;
-    for (int direction = 1; direction <= 8; direction++) {
-        std::vector<RadarObj> results = scan_radar(row, col, direction);
-        all_results.insert(all_results.end(), results.begin(), results.end());
+    std::vector<RadarObj>& results = m_radar_results;
+    results.clear();
+    if (direction >= 0 && direction <= 8) {
+        scan_radar(row, col, direction, results);
     }
     
     // Report findings to robot
-    if (verbose) {
-        if (all_results.empty()) {
-            std::cout << "  checking radar ...  found nothing. \n";
-        } else {
-            std::cout << "  checking radar ...  found '" << all_results[0].m_type 
-                      << "' at (" << all_results[0].m_row << "," << all_results[0].m_col << ")\n";
+    if constexpr (Verbose) {
+        std::cout << "  checking radar (direction " << direction << ") ...  found";
+        if (results.empty()) {
+            std::cout << " nothing.";
         }
+        for (const RadarObj& obj : results) {
+            std::cout << " '" << obj.m_type << "' at (" << obj.m_row << "," << obj.m_col << ")";
+        }
+        std::cout << "\n";
     }
     
-    robot->process_radar_results(all_results);
+    AllocCounter::Pause robot_code;
+    ArenaProfile::Scope callback(m_profile, PROFILE_PROCESS_RADAR_RESULTS, robot_index);
+    robot->process_radar_results(results);
 }
 
-void Arena::handle_movement(int robot_index, bool verbose) 
+template <typename BoardType>
+template <bool Verbose>
+void BasicArena<BoardType>::handle_movement(int robot_index) 
 {
+    ArenaProfile::Scope timer(m_profile, PROFILE_MOVEMENT, robot_index);
     RobotBase* robot = m_robots[robot_index].robot.get();
     
     int direction = 0;
     int distance = 0;
-    robot->get_move_direction(direction, distance);
+    {
+        AllocCounter::Pause robot_code;
+        ArenaProfile::Scope callback(m_profile, PROFILE_GET_MOVE_DIRECTION, robot_index);
+        robot->get_move_direction(direction, distance);
+    }
     
-    if (direction == 0 || distance == 0) {
+    if (direction == 0 || distance <= 0) {
         return; // Robot chose not to move
     }
-    
-    // Get current location
-    int current_row, current_col;
-    robot->get_current_location(current_row, current_col);
+    if (direction < 1 || direction > 8) {
+        return; // Not a direction; would index past directions[]
+    }
+    if (m_state.move[robot_index] == 0) {
+        return; // Movement disabled: the robot stays put, which is not being stuck
+    }
     
     // Calculate new position
-    int move_speed = robot->get_move_speed();
-    distance = std::min(distance, move_speed);
+    int current_row = m_state.row[robot_index];
+    int current_col = m_state.col[robot_index];
+    distance = std::min(distance, m_state.move[robot_index]);
     
+    // Move as far as possible, stopping short of the first mound/robot/dead robot
     auto [dr, dc] = directions[direction];
-    int new_row = current_row + (dr * distance);
-    int new_col = current_col + (dc * distance);
-    
-    // Attempt to move
-    bool moved = move_robot(robot_index, new_row, new_col);
+    int steps = reachable_distance(current_row, current_col, direction, distance);
+    bool moved = steps > 0 && move_robot<Verbose>(robot_index, current_row + dr * steps, current_col + dc * steps);
     
     if (!moved) {
         // Try multiple directions if blocked
-        moved = try_multiple_directions(robot_index, direction, distance);
+        moved = try_multiple_directions<Verbose>(robot_index, direction, distance);
         
         if (!moved) {
             // Track stuck count
@@ -396,7 +517,7 @@ void Arena::handle_movement(int robot_index, bool verbose)
             
             // If stuck for 1+ turns, teleport to random spot (very low tolerance)
             if (m_robots[robot_index].stuck_count >= 1) {
-                handle_stuck_robot(robot_index);
+                handle_stuck_robot<Verbose>(robot_index);
                 moved = true;
             }
         }
@@ -404,253 +525,224 @@ void Arena::handle_movement(int robot_index, bool verbose)
     
     if (moved) {
         m_robots[robot_index].stuck_count = 0;  // Reset stuck counter
-        if (verbose) {
-            int final_row, final_col;
-            robot->get_current_location(final_row, final_col);
-            std::cout << "Moving: " << robot->m_name << " moves to (" 
-                      << final_row << "," << final_col << ").\n";
+        if constexpr (Verbose) {
+            std::cout << "Moving: " << m_robots[robot_index].name << " moves to (" 
+                      << m_state.row[robot_index] << "," << m_state.col[robot_index] << ").\n";
         }
     } else {
-        if (verbose) {
-            std::cout << "Movement blocked for " << robot->m_name << ".\n";
+        if constexpr (Verbose) {
+            std::cout << "Movement blocked for " << m_robots[robot_index].name << ".\n";
         }
     }
 }
 
-void Arena::handle_shooting(int robot_index, bool verbose) 
+template <typename BoardType>
+template <bool Verbose>
+void BasicArena<BoardType>::handle_shooting(int robot_index) 
 {
+    ArenaProfile::Scope timer(m_profile, PROFILE_SHOOTING, robot_index);
     RobotBase* robot = m_robots[robot_index].robot.get();
     
     int shot_row = -1, shot_col = -1;
-    bool wants_to_shoot = robot->get_shot_location(shot_row, shot_col);
+    bool wants_to_shoot;
+    {
+        AllocCounter::Pause robot_code;
+        ArenaProfile::Scope callback(m_profile, PROFILE_GET_SHOT_LOCATION, robot_index);
+        wants_to_shoot = robot->get_shot_location(shot_row, shot_col);
+    }
     
     if (!wants_to_shoot) {
         return;
     }
     
-    int robot_row, robot_col;
-    robot->get_current_location(robot_row, robot_col);
+    int robot_row = m_state.row[robot_index];
+    int robot_col = m_state.col[robot_index];
+    WeaponType weapon = m_state.weapon[robot_index];
     
-    WeaponType weapon = robot->get_weapon();
+    // Which of the 8 directions the target lies in (0 if it is the robot's own cell)
+    int direction = direction_toward(robot_row, robot_col, shot_row, shot_col);
     
-    if (verbose) {
+    if constexpr (Verbose) {
         std::cout << "Shooting: " << weapon << " ";
     }
     
     switch (weapon) {
-        case flamethrower: {
-            // Determine direction to target
-            int dr = (shot_row > robot_row) ? 1 : (shot_row < robot_row) ? -1 : 0;
-            int dc = (shot_col > robot_col) ? 1 : (shot_col < robot_col) ? -1 : 0;
-            
-            // Find direction index
-            int direction = 0;
-            for (int i = 1; i <= 8; i++) {
-                if (directions[i].first == dr && directions[i].second == dc) {
-                    direction = i;
-                    break;
-                }
-            }
+        case flamethrower:
             shoot_flamethrower(robot_row, robot_col, direction);
             break;
-        }
-        case railgun: {
-            int dr = (shot_row > robot_row) ? 1 : (shot_row < robot_row) ? -1 : 0;
-            int dc = (shot_col > robot_col) ? 1 : (shot_col < robot_col) ? -1 : 0;
-            int direction = 0;
-            for (int i = 1; i <= 8; i++) {
-                if (directions[i].first == dr && directions[i].second == dc) {
-                    direction = i;
-                    break;
-                }
-            }
-            shoot_railgun(robot_row, robot_col, direction);
+        case railgun:
+            shoot_railgun(robot_row, robot_col, shot_row, shot_col);
             break;
-        }
         case grenade:
-            if (robot->get_grenades() > 0) {
+            if (m_state.grenades[robot_index] > 0) {
                 shoot_grenade(shot_row, shot_col);
                 robot->decrement_grenades();
-            } else {
+                m_state.grenades[robot_index]--;
+            } else if constexpr (Verbose) {
                 std::cout << "Out of grenades!\n";
             }
             break;
-        case hammer: {
+        case hammer:
             // Hammer hits adjacent cell in direction of target
-            int dr = (shot_row > robot_row) ? 1 : (shot_row < robot_row) ? -1 : 0;
-            int dc = (shot_col > robot_col) ? 1 : (shot_col < robot_col) ? -1 : 0;
-            int direction = 0;
-            for (int i = 1; i <= 8; i++) {
-                if (directions[i].first == dr && directions[i].second == dc) {
-                    direction = i;
-                    break;
-                }
-            }
             shoot_hammer(robot_row, robot_col, direction);
             break;
-        }
     }
 }
 
 // ===== RADAR SYSTEM =====
 
-std::vector<RadarObj> Arena::scan_radar(int row, int col, int direction, int range) 
+template <typename BoardType>
+void BasicArena<BoardType>::scan_radar(int row, int col, int direction, std::vector<RadarObj>& results) 
 {
-    std::vector<RadarObj> results;
-    
-    auto [dr, dc] = directions[direction];
-    
-    // Scan in specified direction up to range
-    for (int dist = 1; dist <= range; dist++) {
-        int check_row = row + (dr * dist);
-        int check_col = col + (dc * dist);
-        
-        if (!is_valid_position(check_row, check_col)) {
-            break;
-        }
-        
-        char cell = m_board[check_row][check_col];
-        
-        if (cell != EMPTY) {
-            results.emplace_back(cell, check_row, check_col);
-            break; // Only return first non-empty object
-        }
-    }
-    
-    return results;
+    // Every object the ray covers, nearest first; how the cells are found is
+    // up to the board's storage
+    m_board.scan_radar(row, col, direction, results);
 }
 
 // ===== SHOOTING/DAMAGE =====
 
-void Arena::shoot_flamethrower(int shooter_row, int shooter_col, int direction) 
+template <typename BoardType>
+void BasicArena<BoardType>::hit_stencil(int row, int col, const Stencil& stencil, int damage) 
 {
-    auto [dr, dc] = directions[direction];
+    // Nothing to hit if no live robot is inside the stencil's bounding rectangle
+    if (stencil.count == 0 ||
+        !m_board.any_robot_in_rect(row + stencil.r0, col + stencil.c0, row + stencil.r1, col + stencil.c1)) {
+        return;
+    }
     
-    // Flamethrower: 3 wide, 4 long box
-    for (int dist = 1; dist <= 4; dist++) {
-        int center_row = shooter_row + (dr * dist);
-        int center_col = shooter_col + (dc * dist);
-        
-        // Hit 3x1 perpendicular to direction
-        for (int offset = -1; offset <= 1; offset++) {
-            int hit_row = center_row + (dc * offset); // Perpendicular
-            int hit_col = center_col + (dr * offset);
-            
-            if (is_valid_position(hit_row, hit_col)) {
-                int target = get_robot_at(hit_row, hit_col);
-                if (target >= 0) {
-                    apply_damage(target, 15, "flamethrower");
-                }
-            }
+    for (int i = 0; i < stencil.count; i++) {
+        int hit_row = row + stencil.cells[i].first;
+        int hit_col = col + stencil.cells[i].second;
+        int target = get_robot_at(hit_row, hit_col);
+        if (target >= 0) {
+            queue_damage(target, damage);
         }
     }
 }
 
-void Arena::shoot_railgun(int shooter_row, int shooter_col, int direction) 
+template <typename BoardType>
+void BasicArena<BoardType>::shoot_flamethrower(int shooter_row, int shooter_col, int direction) 
 {
-    auto [dr, dc] = directions[direction];
+    // Flamethrower: 3 wide, 4 long box
+    hit_stencil(shooter_row, shooter_col, FLAMETHROWER_STENCILS[direction], 15);
+}
+
+template <typename BoardType>
+void BasicArena<BoardType>::shoot_railgun(int shooter_row, int shooter_col, int target_row, int target_col) 
+{
+    // Railgun: through the target cell and on across the entire arena
+    ShotLine line(shooter_row, shooter_col, target_row, target_col);
+    if (!line.valid()) {
+        return;
+    }
     
-    // Railgun: straight line across entire arena
-    int current_row = shooter_row + dr;
-    int current_col = shooter_col + dc;
+    int row = shooter_row;
+    int col = shooter_col;
+    if (line.is_direction()) {
+        // Along one of the 8 directions: jump from one live robot on the line
+        // to the next instead of visiting every cell in between
+        int direction = direction_toward(shooter_row, shooter_col, target_row, target_col);
+        auto [dr, dc] = directions[direction];
+        for (int steps = m_board.nearest_robot(row, col, dr, dc); steps > 0;
+             steps = m_board.nearest_robot(row, col, dr, dc)) {
+            row += dr * steps;
+            col += dc * steps;
+            int target = get_robot_at(row, col);
+            if (target >= 0) {
+                queue_damage(target, 12);
+            }
+        }
+        return;
+    }
     
-    while (is_valid_position(current_row, current_col)) {
-        int target = get_robot_at(current_row, current_col);
+    // Any other angle: walk the rasterized line to the edge
+    for (line.next(row, col); is_valid_position(row, col); line.next(row, col)) {
+        int target = m_board.robot_at(row, col);
         if (target >= 0) {
-            apply_damage(target, 12, "railgun");
+            queue_damage(target, 12);
         }
-        
-        current_row += dr;
-        current_col += dc;
     }
 }
 
-void Arena::shoot_grenade(int target_row, int target_col) 
+template <typename BoardType>
+void BasicArena<BoardType>::shoot_grenade(int target_row, int target_col) 
 {
     // Grenade: 3x3 area
-    for (int dr = -1; dr <= 1; dr++) {
-        for (int dc = -1; dc <= 1; dc++) {
-            int hit_row = target_row + dr;
-            int hit_col = target_col + dc;
-            
-            if (is_valid_position(hit_row, hit_col)) {
-                int target = get_robot_at(hit_row, hit_col);
-                if (target >= 0) {
-                    apply_damage(target, 20, "grenade");
-                }
-            }
-        }
-    }
+    hit_stencil(target_row, target_col, GRENADE_STENCIL, 20);
 }
 
-void Arena::shoot_hammer(int shooter_row, int shooter_col, int direction) 
+template <typename BoardType>
+void BasicArena<BoardType>::shoot_hammer(int shooter_row, int shooter_col, int direction) 
 {
-    auto [dr, dc] = directions[direction];
-    
     // Hammer: just one adjacent cell
-    int hit_row = shooter_row + dr;
-    int hit_col = shooter_col + dc;
-    
-    if (is_valid_position(hit_row, hit_col)) {
-        int target = get_robot_at(hit_row, hit_col);
-        if (target >= 0) {
-            apply_damage(target, 25, "hammer");
-        }
-    }
+    hit_stencil(shooter_row, shooter_col, HAMMER_STENCILS[direction], 25);
 }
 
-void Arena::apply_damage(int robot_index, int damage, const std::string& /*source*/) 
+template <typename BoardType>
+void BasicArena<BoardType>::queue_damage(int robot_index, int damage) 
 {
-    RobotInfo& info = m_robots[robot_index];
-    
-    // Reduce armor first
-    if (info.robot->get_armor() > 0) {
-        info.robot->reduce_armor(1);
-        damage -= 3; // Armor reduces damage
-    }
-    
-    int remaining_health = info.robot->take_damage(damage);
-    
-    std::cout << info.robot->m_name << " takes " << damage 
-              << " damage. Health: " << remaining_health << "\n";
-    
-    if (remaining_health <= 0) {
-        info.is_alive = false;
-        m_alive_count--;
+    m_damage_events.push_back(DamageEvent{ robot_index, damage });
+}
+
+template <typename BoardType>
+template <bool Verbose>
+void BasicArena<BoardType>::resolve_damage() 
+{
+    // Hits resolve in the order they landed. Each one costs a point of armor
+    // (and 3 damage) while the target has armor; a robot that is destroyed
+    // ignores the hits after the one that destroyed it.
+    for (const DamageEvent& event : m_damage_events) {
+        int target = event.target;
+        if (!m_state.alive[target]) {
+            continue;
+        }
+        
+        int damage = event.damage;
+        RobotBase* robot = m_robots[target].robot.get();
+        if (m_state.armor[target] > 0) {
+            robot->reduce_armor(1);
+            m_state.armor[target]--;
+            damage -= 3; // Armor reduces damage
+        }
         
-        int row, col;
-        info.robot->get_current_location(row, col);
-        m_board[row][col] = DEAD_ROBOT;
+        int remaining_health = robot->take_damage(damage);
+        m_state.health[target] = remaining_health;
         
-        std::cout << info.robot->m_name << " is DESTROYED!\n";
+        if constexpr (Verbose) {
+            std::cout << m_robots[target].name << " takes " << damage 
+                      << " damage. Health: " << remaining_health << "\n";
+        }
+        
+        if (remaining_health <= 0) {
+            m_state.alive[target] = 0;
+            m_alive_count--;
+            m_board.set(m_state.row[target], m_state.col[target], DEAD_ROBOT);
+            
+            if constexpr (Verbose) {
+                std::cout << m_robots[target].name << " is DESTROYED!\n";
+            }
+        }
     }
+    m_damage_events.clear();
 }
 
 // ===== MOVEMENT & COLLISION =====
 
-bool Arena::can_move_to(int row, int col) 
+template <typename BoardType>
+bool BasicArena<BoardType>::can_move_to(int row, int col) 
 {
     if (!is_valid_position(row, col)) {
         return false;
     }
     
-    char cell = m_board[row][col];
-    
     // Can move to empty spaces, pits, and flamethrowers (take damage but can move)
-    // Can't move through mounds or other robots
-    if (cell == MOUND) {
-        return false;
-    }
-    
-    // Check if it's another robot (characters ! and @)
-    if (cell == '!' || cell == '@') {
-        return false;
-    }
-    
-    return true;
+    // Can't move onto mounds, other robots or dead robots
+    return !m_board.is_blocked(row, col);
 }
 
-bool Arena::move_robot(int robot_index, int new_row, int new_col) 
+template <typename BoardType>
+template <bool Verbose>
+bool BasicArena<BoardType>::move_robot(int robot_index, int new_row, int new_col) 
 {
     if (!can_move_to(new_row, new_col)) {
         return false;
@@ -660,10 +752,10 @@ bool Arena::move_robot(int robot_index, int new_row, int new_col)
     clear_robot_from_board(robot_index);
     
     // Update robot location
-    m_robots[robot_index].robot->move_to(new_row, new_col);
+    set_robot_location(robot_index, new_row, new_col);
     
     // Check for obstacle effects
-    check_obstacle_effects(robot_index, new_row, new_col);
+    check_obstacle_effects<Verbose>(robot_index, new_row, new_col);
     
     // Place on new position
     place_robot_on_board(robot_index, new_row, new_col);
@@ -671,70 +763,79 @@ bool Arena::move_robot(int robot_index, int new_row, int new_col)
     return true;
 }
 
-void Arena::check_obstacle_effects(int robot_index, int row, int col) 
+template <typename BoardType>
+template <bool Verbose>
+void BasicArena<BoardType>::check_obstacle_effects(int robot_index, int row, int col) 
 {
-    char cell = m_board[row][col];
+    char cell = m_board.at(row, col);
     RobotInfo& info = m_robots[robot_index];
     
     if (cell == PIT) {
-        std::cout << info.robot->m_name << " fell into a PIT!\n";
-        info.in_pit = true;
+        if constexpr (Verbose) {
+            std::cout << info.name << " fell into a PIT!\n";
+        }
+        m_state.in_pit[robot_index] = 1;
         info.robot->disable_movement();
+        m_state.move[robot_index] = 0;
     }
     else if (cell == FLAMETHROWER) {
-        std::cout << info.robot->m_name << " triggered a FLAMETHROWER!\n";
-        apply_damage(robot_index, 15, "obstacle flamethrower");
+        if constexpr (Verbose) {
+            std::cout << info.name << " triggered a FLAMETHROWER!\n";
+        }
+        queue_damage(robot_index, 15);
     }
 }
 
 // ===== BOARD UTILITIES =====
 
-void Arena::clear_robot_from_board(int robot_index) 
+template <typename BoardType>
+void BasicArena<BoardType>::set_robot_location(int robot_index, int row, int col) 
 {
-    int row, col;
-    m_robots[robot_index].robot->get_current_location(row, col);
+    m_robots[robot_index].robot->move_to(row, col);
+    m_state.row[robot_index] = row;
+    m_state.col[robot_index] = col;
+}
+
+template <typename BoardType>
+void BasicArena<BoardType>::clear_robot_from_board(int robot_index) 
+{
+    int row = m_state.row[robot_index];
+    int col = m_state.col[robot_index];
     
-    if (is_valid_position(row, col)) {
-        char cell = m_board[row][col];
-        // Only clear if it's this robot
-        if (cell == m_robots[robot_index].robot->m_character) {
-            m_board[row][col] = EMPTY;
-        }
+    // Only clear if it's this robot
+    if (is_valid_position(row, col) && m_board.robot_at(row, col) == robot_index) {
+        m_board.set(row, col, EMPTY);
     }
 }
 
-void Arena::place_robot_on_board(int robot_index, int row, int col) 
+template <typename BoardType>
+void BasicArena<BoardType>::place_robot_on_board(int robot_index, int row, int col) 
 {
     if (is_valid_position(row, col)) {
-        m_board[row][col] = m_robots[robot_index].robot->m_character;
+        m_board.set_robot(row, col, m_robots[robot_index].robot->m_character, robot_index);
     }
 }
 
-int Arena::get_robot_at(int row, int col) 
+template <typename BoardType>
+int BasicArena<BoardType>::get_robot_at(int row, int col) 
 {
     if (!is_valid_position(row, col)) {
         return -1;
     }
     
-    char cell = m_board[row][col];
-    
-    // Check if it's a robot symbol
-    auto it = m_robot_symbol_to_index.find(cell);
-    if (it != m_robot_symbol_to_index.end()) {
-        return it->second;
-    }
-    
-    return -1;
+    return m_board.robot_at(row, col);
 }
 
-bool Arena::is_valid_position(int row, int col) const 
+template <typename BoardType>
+bool BasicArena<BoardType>::is_valid_position(int row, int col) const 
 {
-    return row >= 0 && row < m_rows && col >= 0 && col < m_cols;
+    return m_board.is_valid_position(row, col);
 }
 
 // ===== DISPLAY =====
 
-void Arena::display_board() const 
+template <typename BoardType>
+void BasicArena<BoardType>::display_board() const 
 {
     // Print column numbers
     std::cout << "    ";
@@ -747,13 +848,14 @@ void Arena::display_board() const
     for (int r = 0; r < m_rows; r++) {
         std::cout << std::setw(2) << r << "  ";
         for (int c = 0; c < m_cols; c++) {
-            std::cout << " " << m_board[r][c] << " ";
+            std::cout << " " << m_board.at(r, c) << " ";
         }
         std::cout << "\n\n";
     }
 }
 
-void Arena::display_robot_info(int robot_index) const 
+template <typename BoardType>
+void BasicArena<BoardType>::display_robot_info(int robot_index) const 
 {
     const RobotBase* robot = m_robots[robot_index].robot.get();
     if (robot) {
@@ -761,38 +863,42 @@ void Arena::display_robot_info(int robot_index) const
     }
 }
 
-void Arena::print_separator() const 
+template <typename BoardType>
+void BasicArena<BoardType>::print_separator() const 
 {
     std::cout << "========================================\n";
 }
 
 // ===== GAME STATE =====
 
-bool Arena::is_game_over() const 
+template <typename BoardType>
+bool BasicArena<BoardType>::is_game_over() const 
 {
     return m_alive_count <= 1 || m_round >= m_max_rounds;
 }
 
-int Arena::get_winner() const 
+template <typename BoardType>
+int BasicArena<BoardType>::get_winner() const 
 {
     for (size_t i = 0; i < m_robots.size(); i++) {
-        if (m_robots[i].is_alive) {
+        if (m_state.alive[i]) {
             return i;
         }
     }
     return -1;
 }
 
-void Arena::announce_winner() const 
+template <typename BoardType>
+void BasicArena<BoardType>::announce_winner() const 
 {
     if (m_round >= m_max_rounds) {
         print_separator();
         std::cout << "\n⏱️  TIMEOUT: Maximum rounds (" << m_max_rounds << ") reached!\n";
         std::cout << "Survivors:\n";
         for (size_t i = 0; i < m_robots.size(); i++) {
-            if (m_robots[i].is_alive && m_robots[i].robot) {
-                std::cout << "  - " << m_robots[i].robot->m_name 
-                          << " (Health: " << m_robots[i].robot->get_health() << ")\n";
+            if (m_state.alive[i] && m_robots[i].robot) {
+                std::cout << "  - " << m_robots[i].name 
+                          << " (Health: " << m_state.health[i] << ")\n";
             }
         }
         print_separator();
@@ -802,7 +908,7 @@ void Arena::announce_winner() const
     int winner = get_winner();
     if (winner >= 0 && m_robots[winner].robot) {
         print_separator();
-        std::cout << "\n🏆 WINNER: " << m_robots[winner].robot->m_name 
+        std::cout << "\n🏆 WINNER: " << m_robots[winner].name 
                   << " " << m_robots[winner].robot->m_character << " 🏆\n";
         display_robot_info(winner);
         print_separator();
@@ -811,58 +917,116 @@ void Arena::announce_winner() const
     }
 }
 
+template <typename BoardType>
+void BasicArena<BoardType>::print_result() const 
+{
+    // One line per game so batch runs can be piped straight into a results file:
+    // rounds=<n> winner=<name|none|timeout> <name>:<health> ...
+    int winner = get_winner();
+    std::cout << "rounds=" << m_round << " winner=";
+    if (m_round >= m_max_rounds && m_alive_count > 1) {
+        std::cout << "timeout";
+    } else if (winner >= 0 && m_robots[winner].robot) {
+        std::cout << m_robots[winner].name;
+    } else {
+        std::cout << "none";
+    }
+    for (size_t i = 0; i < m_robots.size(); i++) {
+        if (m_robots[i].robot) {
+            std::cout << " " << m_robots[i].name << ":" << (m_state.alive[i] ? m_state.health[i] : 0);
+        }
+    }
+    std::cout << "\n";
+}
+
+template <typename BoardType>
+long long BasicArena<BoardType>::steady_state_allocations() const 
+{
+    return m_steady_allocs;
+}
+
+template <typename BoardType>
+const ArenaProfile& BasicArena<BoardType>::profile() const 
+{
+    return m_profile;
+}
+
+template <typename BoardType>
+std::vector<std::string> BasicArena<BoardType>::robot_names() const 
+{
+    std::vector<std::string> names;
+    for (const auto& info : m_robots) {
+        names.push_back(info.name);
+    }
+    return names;
+}
+
+template <typename BoardType>
+GameResult BasicArena<BoardType>::get_result() const 
+{
+    GameResult result;
+    result.rounds = m_round;
+    result.timeout = m_round >= m_max_rounds && m_alive_count > 1;
+    result.winner = (m_alive_count == 1) ? get_winner() : -1;
+    
+    for (size_t i = 0; i < m_robots.size(); i++) {
+        RobotResult robot_result;
+        robot_result.name = m_robots[i].name;
+        robot_result.library = m_robots[i].library;
+        robot_result.is_alive = m_state.alive[i];
+        robot_result.health = (m_state.alive[i] && m_robots[i].robot) ? m_state.health[i] : 0;
+        result.robots.push_back(robot_result);
+    }
+    return result;
+}
+
 // ===== MOVEMENT HELPERS =====
 
-bool Arena::try_multiple_directions(int robot_index, int preferred_direction, int distance) 
+template <typename BoardType>
+template <bool Verbose>
+bool BasicArena<BoardType>::try_multiple_directions(int robot_index, int preferred_direction, int distance) 
 {
-    RobotBase* robot = m_robots[robot_index].robot.get();
-    int current_row, current_col;
-    robot->get_current_location(current_row, current_col);
+    int current_row = m_state.row[robot_index];
+    int current_col = m_state.col[robot_index];
     
     // Try all 8 directions in order: preferred, adjacent, opposite, etc.
-    std::vector<int> try_order;
+    std::array<int, 8> try_order;
+    int tries = 0;
     
     // Start with preferred
-    try_order.push_back(preferred_direction);
+    try_order[tries++] = preferred_direction;
     
     // Try directions adjacent to preferred
     int left = (preferred_direction == 1) ? 8 : preferred_direction - 1;
     int right = (preferred_direction == 8) ? 1 : preferred_direction + 1;
-    try_order.push_back(left);
-    try_order.push_back(right);
+    try_order[tries++] = left;
+    try_order[tries++] = right;
     
     // Try remaining directions
     for (int dir = 1; dir <= 8; dir++) {
         if (dir != preferred_direction && dir != left && dir != right) {
-            try_order.push_back(dir);
+            try_order[tries++] = dir;
         }
     }
     
-    // Try each direction with original distance, then with distance=1
-    for (int dist = distance; dist >= 1; dist--) {
-        for (int dir : try_order) {
-            auto [dr, dc] = directions[dir];
-            int new_row = current_row + (dr * dist);
-            int new_col = current_col + (dc * dist);
-            
-            if (move_robot(robot_index, new_row, new_col)) {
-                return true;
-            }
+    // Take the first direction with any room, going as far as it allows
+    for (int dir : try_order) {
+        int steps = reachable_distance(current_row, current_col, dir, distance);
+        auto [dr, dc] = directions[dir];
+        if (steps > 0 && move_robot<Verbose>(robot_index, current_row + dr * steps, current_col + dc * steps)) {
+            return true;
         }
     }
     
-    // Last resort: try all directions with distance 1 in random order
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::vector<int> all_dirs = {1, 2, 3, 4, 5, 6, 7, 8};
-    std::shuffle(all_dirs.begin(), all_dirs.end(), gen);
-    
+    // Last resort: one step in each direction, in random order (Fisher-Yates
+    // on the game's generator, so the order replays exactly)
+    std::array<int, 8> all_dirs = {1, 2, 3, 4, 5, 6, 7, 8};
+    for (int i = 7; i > 0; i--) {
+        std::swap(all_dirs[i], all_dirs[m_rng.below(i + 1)]);
+    }
     for (int dir : all_dirs) {
         auto [dr, dc] = directions[dir];
-        int new_row = current_row + dr;
-        int new_col = current_col + dc;
-        
-        if (move_robot(robot_index, new_row, new_col)) {
+        if (move_robot<Verbose>(robot_index, current_row + dr, current_col + dc)) {
             return true;
         }
     }
@@ -870,67 +1034,81 @@ bool Arena::try_multiple_directions(int robot_index, int preferred_direction, in
     return false;
 }
 
-void Arena::handle_stuck_robot(int robot_index) 
+template <typename BoardType>
+int BasicArena<BoardType>::reachable_distance(int row, int col, int direction, int distance) const 
 {
-    RobotBase* robot = m_robots[robot_index].robot.get();
+    auto [dr, dc] = directions[direction];
+    
+    // Cells left before the edge of the arena
+    if (dr != 0) {
+        distance = std::min(distance, dr > 0 ? m_board.rows() - 1 - row : row);
+    }
+    if (dc != 0) {
+        distance = std::min(distance, dc > 0 ? m_board.cols() - 1 - col : col);
+    }
     
+    // Stop on the cell before the nearest blocker
+    int blocker = m_board.nearest_blocker(row, col, dr, dc);
+    if (blocker > 0) {
+        distance = std::min(distance, blocker - 1);
+    }
+    return distance;
+}
+
+template <typename BoardType>
+template <bool Verbose>
+void BasicArena<BoardType>::handle_stuck_robot(int robot_index) 
+{
     // Clear robot from current position
     clear_robot_from_board(robot_index);
     
     // Try to teleport to an empty spot near the center
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> row_dist(0, m_rows - 1);
-    std::uniform_int_distribution<> col_dist(0, m_cols - 1);
-    
-    // First try center area (50x50 attempts in center)
+    // First try center area (50 attempts in center)
     int center_row = m_rows / 2;
     int center_col = m_cols / 2;
     int center_range = m_rows / 3;  // Search within 1/3 of board from center
     
-    for (int attempt = 0; attempt < 100; attempt++) {
-        int r, c;
-        if (attempt < 50) {
-            // Try within center range first
-            r = center_row + (int)(row_dist(gen) % (2 * center_range + 1)) - center_range;
-            c = center_col + (int)(col_dist(gen) % (2 * center_range + 1)) - center_range;
-            r = std::max(0, std::min(m_rows - 1, r));
-            c = std::max(0, std::min(m_cols - 1, c));
-        } else {
-            // If center fails, try random locations
-            r = row_dist(gen);
-            c = col_dist(gen);
-        }
-        
-        if (m_board[r][c] == EMPTY) {
-            robot->move_to(r, c);
-            place_robot_on_board(robot_index, r, c);
-            m_robots[robot_index].stuck_count = 0;
-            std::cout << "🔄 " << robot->m_name << " teleported to (" << r << "," << c << ") to escape!\n";
-            return;
-        }
+    int r = 0, c = 0;
+    bool found = false;
+    for (int attempt = 0; attempt < 50 && !found; attempt++) {
+        r = center_row + m_rng.uniform(-center_range, center_range);
+        c = center_col + m_rng.uniform(-center_range, center_range);
+        r = std::max(0, std::min(m_rows - 1, r));
+        c = std::max(0, std::min(m_cols - 1, c));
+        found = m_board.at(r, c) == EMPTY;
+    }
+    
+    // If center fails, take any empty cell (there is at least the one just left)
+    if (!found) {
+        found = m_board.random_free_cell(m_rng, r, c);
     }
     
-    // If we still couldn't find a spot, just reset and hope next round is better
+    if (found) {
+        set_robot_location(robot_index, r, c);
+        place_robot_on_board(robot_index, r, c);
+        if constexpr (Verbose) {
+            std::cout << "🔄 " << m_robots[robot_index].name << " teleported to (" << r << "," << c << ") to escape!\n";
+        }
+    }
     m_robots[robot_index].stuck_count = 0;
 }
 
-void Arena::handle_pit_escape(int robot_index, bool verbose) 
+template <typename BoardType>
+template <bool Verbose>
+void BasicArena<BoardType>::handle_pit_escape(int robot_index) 
 {
-    RobotBase* robot = m_robots[robot_index].robot.get();
-    RobotInfo& info = m_robots[robot_index];
+    ArenaProfile::Scope timer(m_profile, PROFILE_PIT_ESCAPE, robot_index);
     
-    // Get current location
-    int current_row, current_col;
-    robot->get_current_location(current_row, current_col);
+    int current_row = m_state.row[robot_index];
+    int current_col = m_state.col[robot_index];
     
     // Try to move out of pit (adjacent cells first)
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    
-    // Try all 8 adjacent directions from pit
-    std::vector<int> escape_dirs = {1, 2, 3, 4, 5, 6, 7, 8};
-    std::shuffle(escape_dirs.begin(), escape_dirs.end(), gen);
+    // Try all 8 adjacent directions from pit, in random order (Fisher-Yates on
+    // the game's generator, so the order replays exactly)
+    std::array<int, 8> escape_dirs = {1, 2, 3, 4, 5, 6, 7, 8};
+    for (int i = 7; i > 0; i--) {
+        std::swap(escape_dirs[i], escape_dirs[m_rng.below(i + 1)]);
+    }
     
     for (int dir : escape_dirs) {
         auto [dr, dc] = directions[dir];
@@ -942,42 +1120,44 @@ void Arena::handle_pit_escape(int robot_index, bool verbose)
             clear_robot_from_board(robot_index);
             
             // Move out of pit
-            robot->move_to(new_row, new_col);
+            set_robot_location(robot_index, new_row, new_col);
             place_robot_on_board(robot_index, new_row, new_col);
             
             // Escaped pit!
-            info.in_pit = false;
-            if (verbose) {
-                std::cout << "💨 " << robot->m_name << " escaped the pit!\n";
+            leave_pit(robot_index);
+            if constexpr (Verbose) {
+                std::cout << "💨 " << m_robots[robot_index].name << " escaped the pit!\n";
             }
             return;
         }
     }
     
     // If stuck, teleport randomly as last resort
-    std::uniform_int_distribution<> row_dist(0, m_rows - 1);
-    std::uniform_int_distribution<> col_dist(0, m_cols - 1);
-    
-    for (int attempt = 0; attempt < 50; attempt++) {
-        int r = row_dist(gen);
-        int c = col_dist(gen);
-        
-        if (m_board[r][c] == EMPTY) {
-            clear_robot_from_board(robot_index);
-            robot->move_to(r, c);
-            place_robot_on_board(robot_index, r, c);
-            info.in_pit = false;
-            if (verbose) {
-                std::cout << "🚀 " << robot->m_name << " teleported out of pit to (" << r << "," << c << ")!\n";
-            }
-            return;
+    int r, c;
+    if (m_board.random_free_cell(m_rng, r, c)) {
+        clear_robot_from_board(robot_index);
+        set_robot_location(robot_index, r, c);
+        place_robot_on_board(robot_index, r, c);
+        leave_pit(robot_index);
+        if constexpr (Verbose) {
+            std::cout << "🚀 " << m_robots[robot_index].name << " teleported out of pit to (" << r << "," << c << ")!\n";
         }
     }
 }
 
+template <typename BoardType>
+void BasicArena<BoardType>::leave_pit(int robot_index) 
+{
+    // Out of the pit the robot moves at its own speed again
+    m_state.in_pit[robot_index] = 0;
+    m_robots[robot_index].robot->enable_movement(m_robots[robot_index].move_speed);
+    m_state.move[robot_index] = m_robots[robot_index].move_speed;
+}
+
 // ===== CLEANUP =====
 
-void Arena::unload_robots() 
+template <typename BoardType>
+void BasicArena<BoardType>::unload_robots() 
 {
     // First, explicitly delete all robot objects while their code is still loaded
     for (auto& info : m_robots) {
@@ -992,4 +1172,22 @@ void Arena::unload_robots()
         }
     }
     m_robots.clear();
+    m_state.clear();
 }
+
+// The board storage policies the arena is built with
+template class BasicArena<FlatBoard>;
+template class BasicArena<TiledBoard>;
+template class BasicArena<FixedBoard<STANDARD_ROWS, STANDARD_COLS>>;
+
+// Member templates are not covered by the lines above. The quiet steps that
+// bench.cpp drives on their own are instantiated here for every storage.
+template bool Arena::move_robot<false>(int, int, int);
+template bool Arena::try_multiple_directions<false>(int, int, int);
+template void Arena::resolve_damage<false>();
+template bool TiledArena::move_robot<false>(int, int, int);
+template bool TiledArena::try_multiple_directions<false>(int, int, int);
+template void TiledArena::resolve_damage<false>();
+template bool StandardArena::move_robot<false>(int, int, int);
+template bool StandardArena::try_multiple_directions<false>(int, int, int);
+template void StandardArena::resolve_damage<false>();
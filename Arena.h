@@ -3,83 +3,146 @@
 #include <vector>
 #include <string>
 #include <memory>
-#include <map>
 #include <thread>
 #include <chrono>
+#include <dlfcn.h>
 #include "RobotBase.h"
 #include "RadarObj.h"
+#include "RobotCompiler.h"
+#include "Board.h"
+#include "TiledBoard.h"
+#include "GameRng.h"
+#include "RobotState.h"
+#include "WeaponStencils.h"
+#include "ArenaProfile.h"
 
-enum CellType {
-    EMPTY = '.',
-    ROBOT = 'R',
-    DEAD_ROBOT = 'X',
-    MOUND = 'M',
-    PIT = 'P',
-    FLAMETHROWER = 'F'
-};
-
+// Per-robot bookkeeping the turn loop rarely touches; the hot fields (location,
+// health, armor, move, weapon, alive and pit flags) are in the arena's RobotState
 struct RobotInfo {
     std::unique_ptr<RobotBase> robot;
+    std::string name;      // Display name ("Ratboy", "Ratboy#2"); the robot gets it via name_robot()
+    int library;           // Caller's id for the library the robot came from, -1 if none
     void* lib_handle;
-    bool is_alive;
-    bool in_pit;
     int stuck_count;
     int pit_turns;
+    int move_speed;        // Speed the robot was built with, given back when it leaves a pit
     
-    RobotInfo() : robot(nullptr), lib_handle(nullptr), is_alive(true), in_pit(false), stuck_count(0), pit_turns(0) {}
+    RobotInfo() : robot(nullptr), library(-1), lib_handle(nullptr), stuck_count(0), pit_turns(0), move_speed(0) {}
+};
+
+// set_robot_name in libRobotBase.so, looked up in the robot's own namespace
+typedef decltype(&set_robot_name) RobotNameSetter;
+
+// One hit waiting to be resolved: damage before armor to a robot index
+struct DamageEvent {
+    int target;
+    int damage;
+};
+
+// Final state of one robot after a game (used by batch/tournament runners)
+struct RobotResult {
+    std::string name;
+    int library;       // as given to add_robot / load_robot_library
+    bool is_alive;
+    int health;
 };
 
-class Arena {
+struct GameResult {
+    int rounds;
+    int winner;        // robot index, -1 if nobody (or more than one robot) survived
+    bool timeout;
+    std::vector<RobotResult> robots;
+};
+
+// One game of RobotWarz, templated on how the board is stored (see Board.h):
+// StandardArena (FixedBoard) for the standard 20x20 board, Arena (FlatBoard)
+// for other ordinary sizes, TiledArena (TiledBoard) for huge sparse arenas.
+// All three are instantiated in Arena.cpp.
+template <typename BoardType>
+class BasicArena {
 private:
     int m_rows;
     int m_cols;
     
-    std::vector<std::vector<char>> m_board;
+    BoardType m_board;
     
     std::vector<RobotInfo> m_robots;
-    std::map<char, int> m_robot_symbol_to_index;
+    RobotState m_state;    // Hot robot fields, mirrored from RobotBase as the arena changes them
     
     int m_round;
     int m_alive_count;
     int m_max_rounds;  // Prevent infinite loops
+    bool m_headless;   // Batch mode: no board, no sleeps, no per-turn output
+    Lmid_t m_namespace;  // Link-map namespace robot libraries are loaded into
+    GameRng m_rng;     // All arena-side randomness (obstacles, placement, teleports)
+    
+    // Turn-loop scratch space, sized once so a round does not touch the heap
+    std::vector<RadarObj> m_radar_results;
+    std::vector<DamageEvent> m_damage_events;  // hits from the current turn, in the order they landed
+    long long m_steady_allocs;  // arena allocations after round 1 (COUNT_ALLOCS builds)
     
     const std::string ROBOT_SYMBOLS = "!@#$%^&*+=?";
+    static constexpr size_t MAX_ROBOTS = 65535;  // robot ids are stored as uint16_t
+    int m_copies;      // Instances of each robot load_robots() creates
+    double m_obstacle_scale;  // Multiplies the obstacle counts (1 unless a density is set); 0 leaves an open field
+    ArenaProfile m_profile;   // Phase timers (ARENA_PROFILE builds; empty otherwise)
     
 public:
-    Arena(int rows = 20, int cols = 20);
-    ~Arena();
-    
-    bool load_robots(const std::string& directory = ".");
-    bool compile_robot(const std::string& cpp_filename);
-    bool load_robot_library(const std::string& so_filename, const std::string& robot_name);
+    BasicArena(int rows = 20, int cols = 20);
+    ~BasicArena();
+    
+    void set_headless(bool headless);
+    bool is_headless() const;
+    void set_link_namespace(Lmid_t lmid);
+    void set_copies_per_robot(int copies);
+    void set_seed(uint64_t seed, uint64_t game);
+    void set_obstacle_density(double density);  // fraction of the field; 0 leaves it open
+    
+    bool load_robots(const std::string& directory = ".", int jobs = 0,
+                     BuildProfile profile = BuildProfile::release);
+    bool load_robot_library(const std::string& so_path, const std::string& robot_name, int library = -1);
+    bool add_robot(RobotFactory factory, const std::string& robot_name, void* lib_handle = nullptr, int library = -1);
+    void name_robot(int robot_index, const std::string& name);
     
     void initialize_board();
     void place_obstacles();
+    void place_obstacle(int row, int col, CellType obstacle);
     bool place_robot(int robot_index);
+    void reserve_turn_buffers();
     
     void run_game();
+    void play_game();
+    void start_game();      // board set up, ready for round 1
+    void play_round();      // run_round() and count it
     void run_round();
-    void robot_turn(int robot_index);
-    
-    void handle_radar(int robot_index, bool verbose = true);
-    void handle_movement(int robot_index, bool verbose = true);
-    void handle_shooting(int robot_index, bool verbose = true);
-    bool try_multiple_directions(int robot_index, int preferred_direction, int distance);
-    void handle_stuck_robot(int robot_index);
-    void handle_pit_escape(int robot_index, bool verbose = true);
-    
-    std::vector<RadarObj> scan_radar(int row, int col, int direction, int range = 5);
     
+    // The turn pipeline, built twice: Verbose logs every step as it happens,
+    // the quiet version (headless games) compiles without any output code
+    template <bool Verbose> void robot_turn(int robot_index);
+    template <bool Verbose> void handle_radar(int robot_index);
+    template <bool Verbose> void handle_movement(int robot_index);
+    template <bool Verbose> void handle_shooting(int robot_index);
+    template <bool Verbose> bool try_multiple_directions(int robot_index, int preferred_direction, int distance);
+    int reachable_distance(int row, int col, int direction, int distance) const;
+    template <bool Verbose> void handle_stuck_robot(int robot_index);
+    template <bool Verbose> void handle_pit_escape(int robot_index);
+    void leave_pit(int robot_index);
+    
+    void scan_radar(int row, int col, int direction, std::vector<RadarObj>& results);
+    
+    void hit_stencil(int row, int col, const Stencil& stencil, int damage);
     void shoot_flamethrower(int shooter_row, int shooter_col, int direction);
-    void shoot_railgun(int shooter_row, int shooter_col, int direction);
+    void shoot_railgun(int shooter_row, int shooter_col, int target_row, int target_col);
     void shoot_grenade(int target_row, int target_col);
     void shoot_hammer(int shooter_row, int shooter_col, int direction);
-    void apply_damage(int robot_index, int damage, const std::string& source);
+    void queue_damage(int robot_index, int damage);
+    template <bool Verbose> void resolve_damage();
     
     bool can_move_to(int row, int col);
-    bool move_robot(int robot_index, int new_row, int new_col);
-    void check_obstacle_effects(int robot_index, int row, int col);
+    template <bool Verbose> bool move_robot(int robot_index, int new_row, int new_col);
+    template <bool Verbose> void check_obstacle_effects(int robot_index, int row, int col);
     
+    void set_robot_location(int robot_index, int row, int col);
     void clear_robot_from_board(int robot_index);
     void place_robot_on_board(int robot_index, int row, int col);
     int get_robot_at(int row, int col);
@@ -92,6 +155,19 @@ public:
     bool is_game_over() const;
     int get_winner() const;
     void announce_winner() const;
+    void print_result() const;
+    GameResult get_result() const;
+    const ArenaProfile& profile() const;
+    std::vector<std::string> robot_names() const;
+    long long steady_state_allocations() const;
     
     void unload_robots();
 };
+
+extern template class BasicArena<FlatBoard>;
+extern template class BasicArena<TiledBoard>;
+extern template class BasicArena<FixedBoard<STANDARD_ROWS, STANDARD_COLS>>;
+
+using Arena = BasicArena<FlatBoard>;
+using TiledArena = BasicArena<TiledBoard>;
+using StandardArena = BasicArena<FixedBoard<STANDARD_ROWS, STANDARD_COLS>>;
@@ -0,0 +1,92 @@
+#include "ArenaProfile.h"
+
+#ifdef ARENA_PROFILE
+
+#include <iomanip>
+#include <cstring>
+
+// One line per phase that was entered: calls, total milliseconds, average ns
+static void print_counters(std::ostream& out, const ArenaProfile::Counters& counters, const std::string& indent)
+{
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        const ArenaProfile::Counter& counter = counters[phase];
+        if (counter.calls == 0) {
+            continue;
+        }
+        out << indent << std::left << std::setw(24 - (int)indent.size()) << PROFILE_PHASE_NAMES[phase] << std::right
+            << std::setw(10) << counter.calls
+            << std::setw(12) << std::fixed << std::setprecision(3) << counter.ns / 1e6
+            << std::setw(12) << std::setprecision(0) << (double)counter.ns / counter.calls << "\n";
+    }
+}
+
+static void add_counters(ArenaProfile::Counters& to, const ArenaProfile::Counters& from)
+{
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        to[phase].calls += from[phase].calls;
+        to[phase].ns += from[phase].ns;
+    }
+}
+
+void ArenaProfile::clear()
+{
+    m_game = Counters();
+    m_robots.clear();
+}
+
+void ArenaProfile::merge(const ArenaProfile& other, const std::vector<int>& slots)
+{
+    add_counters(m_game, other.m_game);
+    for (size_t i = 0; i < other.m_robots.size(); i++) {
+        size_t slot = i < slots.size() ? slots[i] : i;
+        if (slot >= m_robots.size()) {
+            m_robots.resize(slot + 1);
+        }
+        add_counters(m_robots[slot], other.m_robots[i]);
+    }
+}
+
+// Layout: robot count, then the totals and each robot's counters as they sit in memory
+void ArenaProfile::append_to(std::vector<char>& out) const
+{
+    int robots = m_robots.size();
+    const char* count = reinterpret_cast<const char*>(&robots);
+    out.insert(out.end(), count, count + sizeof(robots));
+    const char* game = reinterpret_cast<const char*>(&m_game);
+    out.insert(out.end(), game, game + sizeof(Counters));
+    const char* per_robot = reinterpret_cast<const char*>(m_robots.data());
+    out.insert(out.end(), per_robot, per_robot + m_robots.size() * sizeof(Counters));
+}
+
+bool ArenaProfile::merge_bytes(const char* data, size_t size)
+{
+    int robots;
+    if (size < sizeof(robots)) {
+        return false;
+    }
+    std::memcpy(&robots, data, sizeof(robots));
+    if (robots < 0 || size != sizeof(robots) + (robots + 1) * sizeof(Counters)) {
+        return false;
+    }
+
+    ArenaProfile other;
+    other.m_robots.resize(robots);
+    std::memcpy(&other.m_game, data + sizeof(robots), sizeof(Counters));
+    std::memcpy(other.m_robots.data(), data + sizeof(robots) + sizeof(Counters), robots * sizeof(Counters));
+    merge(other);
+    return true;
+}
+
+void ArenaProfile::print(std::ostream& out, const std::vector<std::string>& robot_names) const
+{
+    out << "===== PROFILE =====\n";
+    out << std::left << std::setw(24) << "phase" << std::right << std::setw(10) << "calls"
+        << std::setw(12) << "total ms" << std::setw(12) << "avg ns" << "\n";
+    print_counters(out, m_game, "");
+    for (size_t i = 0; i < m_robots.size(); i++) {
+        out << (i < robot_names.size() ? robot_names[i] : "robot " + std::to_string(i)) << "\n";
+        print_counters(out, m_robots[i], "  ");
+    }
+}
+
+#endif
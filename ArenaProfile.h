@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <ostream>
+
+// Where a game spends its time: call counts and wall time per phase of the
+// turn loop, per robot callback and per robot-loading step.
+//
+// Only active in binaries built with -DARENA_PROFILE (make RobotWarz_profile).
+// Otherwise the counters do not exist and a Scope is an empty object, so the
+// timers compile out of the turn loop entirely. Phases nest: a phase's time
+// includes the robot callbacks made inside it.
+//
+// A game's profile is not printed by the arena: the game runners merge every
+// game into one profile (per library in a tournament) and print it at the end.
+enum ProfilePhase {
+    PROFILE_COMPILE,                // load_robots: building (or fetching) the robot libraries
+    PROFILE_DLOPEN,                 // load_robot_library: dlopen, dlsym and the factory call
+    PROFILE_ROUND,
+    PROFILE_RENDER,                 // display_board
+    PROFILE_TURN,
+    PROFILE_RADAR,
+    PROFILE_MOVEMENT,
+    PROFILE_PIT_ESCAPE,
+    PROFILE_SHOOTING,
+    PROFILE_DAMAGE,
+    PROFILE_GET_RADAR_DIRECTION,    // robot callbacks
+    PROFILE_PROCESS_RADAR_RESULTS,
+    PROFILE_GET_MOVE_DIRECTION,
+    PROFILE_GET_SHOT_LOCATION,
+    PROFILE_PHASE_COUNT
+};
+
+constexpr const char* PROFILE_PHASE_NAMES[PROFILE_PHASE_COUNT] = {
+    "compile", "dlopen", "round", "render", "turn", "radar", "movement", "pit escape", "shooting",
+    "damage", "get_radar_direction", "process_radar_results", "get_move_direction", "get_shot_location"
+};
+
+class ArenaProfile {
+public:
+    struct Counter {
+        long long calls = 0;
+        long long ns = 0;
+    };
+    using Counters = std::array<Counter, PROFILE_PHASE_COUNT>;
+
+#ifdef ARENA_PROFILE
+private:
+    Counters m_game;                    // every robot, plus what belongs to no robot
+    std::vector<Counters> m_robots;     // per robot index
+
+public:
+    static constexpr bool enabled() { return true; }
+
+    // Per-robot counters for robots 0..robots-1; the game totals are kept
+    void set_robot_count(int robots) { m_robots.resize(robots); }
+
+    // Robot -1 for phases that belong to the game rather than one robot
+    void record(int robot, ProfilePhase phase, long long ns)
+    {
+        m_game[phase].calls++;
+        m_game[phase].ns += ns;
+        if (robot >= 0) {
+            m_robots[robot][phase].calls++;
+            m_robots[robot][phase].ns += ns;
+        }
+    }
+
+    void clear();
+
+    // Adds another profile to this one: its totals to the totals and its robot
+    // i to robot slots[i] here (robot i itself when slots is empty)
+    void merge(const ArenaProfile& other, const std::vector<int>& slots = {});
+
+    // The counters as raw bytes, for a forked game to send back to its server
+    void append_to(std::vector<char>& out) const;
+    // merge() of a profile written by append_to; false if the bytes are not one
+    bool merge_bytes(const char* data, size_t size);
+
+    // Totals, then each robot's, for every phase that was entered
+    void print(std::ostream& out, const std::vector<std::string>& robot_names) const;
+#else
+    static constexpr bool enabled() { return false; }
+    void set_robot_count(int) {}
+    void record(int, ProfilePhase, long long) {}
+    void clear() {}
+    void merge(const ArenaProfile&, const std::vector<int>& = {}) {}
+    void append_to(std::vector<char>&) const {}
+    bool merge_bytes(const char*, size_t size) { return size == 0; }
+    void print(std::ostream&, const std::vector<std::string>&) const {}
+#endif
+
+    // Times its own lifetime into a phase
+    class Scope {
+#ifdef ARENA_PROFILE
+    private:
+        ArenaProfile& m_profile;
+        ProfilePhase m_phase;
+        int m_robot;
+        std::chrono::steady_clock::time_point m_start;
+
+    public:
+        Scope(ArenaProfile& profile, ProfilePhase phase, int robot = -1)
+            : m_profile(profile), m_phase(phase), m_robot(robot), m_start(std::chrono::steady_clock::now()) {}
+
+        ~Scope()
+        {
+            auto elapsed = std::chrono::steady_clock::now() - m_start;
+            m_profile.record(m_robot, m_phase, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+#else
+    public:
+        Scope(ArenaProfile&, ProfilePhase, int = -1) {}
+#endif
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <bit>
+#include <algorithm>
+#include "BoardDims.h"
+
+// One bit per arena cell, 64 columns to a word, every row starting on a fresh
+// word. Lets the arena ask "is there anything of this kind in this rectangle"
+// or "where is the next one along this row" a whole word at a time instead of
+// reading cells one by one.
+template <typename Dims = RuntimeDims>
+class BasicBitBoard {
+private:
+    static constexpr size_t WORDS = fixed_size<Dims>((size_t)Dims::ROWS * ((Dims::COLS + 63) / 64));
+
+    [[no_unique_address]] Dims m_dims;
+    int m_words;    // words per row (a constant with fixed Dims)
+    BoardStorage<uint64_t, WORDS> m_bits;
+
+    int rows() const { return m_dims.rows(); }
+    int cols() const { return m_dims.cols(); }
+
+    int words() const
+    {
+        if constexpr (Dims::FIXED) {
+            return (Dims::COLS + 63) / 64;
+        }
+        return m_words;
+    }
+
+    // Bits lo..hi (inclusive, word-relative) of a word
+    static uint64_t span(int lo, int hi) { return (~0ULL >> (63 - hi)) & (~0ULL << lo); }
+
+public:
+    BasicBitBoard(int rows = Dims::ROWS, int cols = Dims::COLS) : m_dims(rows, cols), m_words((cols + 63) / 64)
+    {
+        size_storage(m_bits, (size_t)rows * words());
+        clear();
+    }
+
+    void clear() { std::fill(m_bits.begin(), m_bits.end(), 0); }
+
+    bool test(int row, int col) const { return (m_bits[row * words() + (col >> 6)] >> (col & 63)) & 1; }
+    void set(int row, int col) { m_bits[row * words() + (col >> 6)] |= 1ULL << (col & 63); }
+    void reset(int row, int col) { m_bits[row * words() + (col >> 6)] &= ~(1ULL << (col & 63)); }
+
+    // True if any bit is set in rows r0..r1, columns c0..c1 (clipped to the board)
+    bool any_in_rect(int r0, int c0, int r1, int c1) const
+    {
+        r0 = std::max(r0, 0); r1 = std::min(r1, rows() - 1);
+        c0 = std::max(c0, 0); c1 = std::min(c1, cols() - 1);
+        for (int r = r0; r <= r1; r++) {
+            for (int w = c0 >> 6; w <= c1 >> 6; w++) {
+                int lo = std::max(c0 - w * 64, 0);
+                int hi = std::min(c1 - w * 64, 63);
+                if (m_bits[r * words() + w] & span(lo, hi)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Calls visit(row, col) for every set bit in the clipped rectangle, row by row.
+    // Each word is copied before it is visited, so visit may change the board.
+    template <typename Visit>
+    void for_each_in_rect(int r0, int c0, int r1, int c1, Visit visit) const
+    {
+        r0 = std::max(r0, 0); r1 = std::min(r1, rows() - 1);
+        c0 = std::max(c0, 0); c1 = std::min(c1, cols() - 1);
+        for (int r = r0; r <= r1; r++) {
+            for (int w = c0 >> 6; w <= c1 >> 6; w++) {
+                int lo = std::max(c0 - w * 64, 0);
+                int hi = std::min(c1 - w * 64, 63);
+                uint64_t word = m_bits[r * words() + w] & span(lo, hi);
+                while (word) {
+                    visit(r, w * 64 + std::countr_zero(word));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+    // Column of the first set bit after col in this row, walking right (dc = 1)
+    // or left (dc = -1); -1 if there is none before the edge
+    int next_in_row(int row, int col, int dc) const
+    {
+        const uint64_t* bits = &m_bits[row * words()];
+        if (dc > 0) {
+            int start = col + 1;
+            if (start >= cols()) {
+                return -1;
+            }
+            uint64_t word = bits[start >> 6] & (~0ULL << (start & 63));
+            for (int w = start >> 6; ; ) {
+                if (word) {
+                    return w * 64 + std::countr_zero(word);
+                }
+                if (++w >= words()) {
+                    return -1;
+                }
+                word = bits[w];
+            }
+        }
+
+        int start = col - 1;
+        if (start < 0) {
+            return -1;
+        }
+        uint64_t word = bits[start >> 6] & (~0ULL >> (63 - (start & 63)));
+        for (int w = start >> 6; ; ) {
+            if (word) {
+                return w * 64 + 63 - std::countl_zero(word);
+            }
+            if (--w < 0) {
+                return -1;
+            }
+            word = bits[w];
+        }
+    }
+};
+
+using BitBoard = BasicBitBoard<>;
@@ -0,0 +1,152 @@
+#include "Board.h"
+#include <algorithm>
+
+template <typename Dims>
+BasicFlatBoard<Dims>::BasicFlatBoard(int rows, int cols)
+    : m_dims(rows, cols), m_live_lines(rows, cols), m_blocker_lines(rows, cols),
+      m_radar(RadarTable::for_size(rows, cols)),
+      m_free((rows + 2) * (cols + 2), rows * cols)
+{
+    size_storage(m_cells, (rows + 2) * (cols + 2));
+    size_storage(m_robot_ids, m_cells.size());
+    size_storage(m_open, m_cells.size());
+    for (auto& layer : m_layers) {
+        layer = BasicBitBoard<Dims>(rows, cols);
+    }
+    clear();
+}
+
+template <typename Dims>
+void BasicFlatBoard<Dims>::clear()
+{
+    // Walls everywhere, then open up the playing field inside the ring
+    std::fill(m_cells.begin(), m_cells.end(), (char)WALL);
+    for (int r = 0; r < rows(); r++) {
+        std::fill(m_cells.begin() + index(r, 0), m_cells.begin() + index(r, cols()), (char)EMPTY);
+    }
+    std::fill(m_robot_ids.begin(), m_robot_ids.end(), 0);
+    for (auto& layer : m_layers) {
+        layer.clear();
+    }
+    m_live_lines.clear();
+    m_blocker_lines.clear();
+
+    // Every field cell is free, and its empty neighbours are the field cells
+    // in the 3x3 block around it: 8 inside, 5 along an edge, 3 in a corner
+    m_free.clear();
+    std::fill(m_open.begin(), m_open.end(), 0);
+    for (int r = 0; r < rows(); r++) {
+        int block_rows = 1 + (r > 0) + (r < rows() - 1);
+        for (int c = 0; c < cols(); c++) {
+            int block_cols = 1 + (c > 0) + (c < cols() - 1);
+            int i = index(r, c);
+            m_open[i] = block_rows * block_cols - 1;
+            m_free.insert(i);
+            update_roomy(i);
+        }
+    }
+}
+
+template <typename Dims>
+void BasicFlatBoard<Dims>::set(int row, int col, char cell)
+{
+    int i = index(row, col);
+    bool was_free = m_cells[i] == EMPTY;
+    set_layers(row, col, false);
+    m_cells[i] = cell;
+    m_robot_ids[i] = 0;
+    set_layers(row, col, true);
+    if (was_free != (cell == EMPTY)) {
+        set_free(i, cell == EMPTY);
+    }
+}
+
+template <typename Dims>
+void BasicFlatBoard<Dims>::set_robot(int row, int col, char symbol, int robot_index)
+{
+    int i = index(row, col);
+    bool was_free = m_cells[i] == EMPTY;
+    set_layers(row, col, false);
+    m_cells[i] = symbol;
+    m_robot_ids[i] = (uint16_t)(robot_index + 1);
+    set_layers(row, col, true);
+    if (was_free) {
+        set_free(i, false);
+    }
+}
+
+template <typename Dims>
+void BasicFlatBoard<Dims>::set_free(int index, bool free)
+{
+    m_free.set(index, free);
+    update_roomy(index);
+
+    // The neighbours (ring cells included; theirs are never read) gain or lose
+    // an empty neighbour; only one that crosses the threshold changes roominess
+    int delta = free ? 1 : -1;
+    int crossing = free ? ROOMY_NEIGHBOURS : ROOMY_NEIGHBOURS - 1;
+    for (int dr = -1; dr <= 1; dr++) {
+        for (int dc = -1; dc <= 1; dc++) {
+            if (dr != 0 || dc != 0) {
+                int j = index + step(dr, dc);
+                m_open[j] += delta;
+                if (m_open[j] == crossing) {
+                    update_roomy(j);
+                }
+            }
+        }
+    }
+}
+
+template <typename Dims>
+void BasicFlatBoard<Dims>::set_layers(int row, int col, bool present)
+{
+    int i = index(row, col);
+    int kind = layer_of(m_cells[i], m_robot_ids[i] != 0);
+    if (kind < 0) {
+        return;
+    }
+    bool blocks = layer_blocks(kind);
+
+    if (present) {
+        m_layers[kind].set(row, col);
+        m_layers[OCCUPIED].set(row, col);
+        if (blocks) {
+            m_layers[BLOCKERS].set(row, col);
+            m_blocker_lines.set(row, col);
+        }
+        if (kind == LIVE_ROBOTS) {
+            m_live_lines.set(row, col);
+        }
+    } else {
+        m_layers[kind].reset(row, col);
+        m_layers[OCCUPIED].reset(row, col);
+        if (blocks) {
+            m_layers[BLOCKERS].reset(row, col);
+            m_blocker_lines.reset(row, col);
+        }
+        if (kind == LIVE_ROBOTS) {
+            m_live_lines.reset(row, col);
+        }
+    }
+}
+
+template <typename Dims>
+void BasicFlatBoard<Dims>::scan_radar(int row, int col, int direction, std::vector<RadarObj>& results) const
+{
+    // Every cell the ray covers, nearest first; side cells past the edge are WALL
+    int count;
+    const int* offsets = m_radar.ray(row, col, direction, count);
+    int origin = index(row, col);
+
+    for (int i = 0; i < count; i++) {
+        int cell_index = origin + offsets[i];
+        char cell = m_cells[cell_index];
+        if (cell != EMPTY && cell != WALL) {
+            results.emplace_back(cell, row_of(cell_index), col_of(cell_index));
+        }
+    }
+}
+
+template class BasicFlatBoard<RuntimeDims>;
+template class BasicFlatBoard<BoardDims<STANDARD_ROWS, STANDARD_COLS>>;
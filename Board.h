@@ -0,0 +1,215 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "BoardDims.h"
+#include "BitBoard.h"
+#include "LineBitBoard.h"
+#include "RadarObj.h"
+#include "RadarTable.h"
+#include "CellSet.h"
+#include "GameRng.h"
+
+enum CellType {
+    EMPTY = '.',
+    ROBOT = 'R',
+    DEAD_ROBOT = 'X',
+    MOUND = 'M',
+    PIT = 'P',
+    FLAMETHROWER = 'F',
+    WALL = '|'      // sentinel ring around the board, never displayed
+};
+
+// Bit layers the board keeps alongside the cells
+enum BoardLayer {
+    LIVE_ROBOTS,
+    DEAD_ROBOTS,
+    MOUNDS,
+    PITS,
+    FLAMETHROWERS,
+    BLOCKERS,       // anything movement cannot pass: mounds, live and dead robots
+    OCCUPIED,       // anything that is not EMPTY
+    LAYER_COUNT
+};
+
+// Layer of a cell's contents, or -1 for nothing (EMPTY, WALL). A cell with a
+// robot id is a live robot whatever symbol it shows.
+inline int layer_of(char cell, bool has_robot)
+{
+    if (has_robot) {
+        return LIVE_ROBOTS;
+    }
+    switch (cell) {
+        case EMPTY:
+        case WALL:         return -1;
+        case DEAD_ROBOT:   return DEAD_ROBOTS;
+        case MOUND:        return MOUNDS;
+        case PIT:          return PITS;
+        case FLAMETHROWER: return FLAMETHROWERS;
+        default:           return LIVE_ROBOTS;
+    }
+}
+
+// Whether movement is stopped by a cell of this layer
+inline bool layer_blocks(int layer)
+{
+    return layer == LIVE_ROBOTS || layer == DEAD_ROBOTS || layer == MOUNDS;
+}
+
+// Empty neighbours a cell needs to count as roomy; new robots start on a
+// roomy cell so they are not boxed in from their first turn
+constexpr int ROOMY_NEIGHBOURS = 3;
+
+// Board storage policies.
+//
+// BasicArena is templated on its board type, which must provide:
+//   rows(), cols(), is_valid_position(row, col)
+//   at(row, col)           cell contents; WALL just outside the field
+//   robot_at(row, col)     index of the live robot on a cell, or -1
+//   set(row, col, cell), set_robot(row, col, symbol, robot_index), clear()
+//   is_blocked(row, col)   mound, robot or dead robot
+//   nearest_blocker / nearest_robot(row, col, dr, dc)
+//                          steps to the first one in a direction, or -1
+//   any_robot_in_rect(r0, c0, r1, c1), for_each_robot_in_rect(..., visit)
+//   scan_radar(row, col, direction, results), max_radar_cells()
+//   random_free_cell(rng, row, col)
+//                          some empty cell; false only if there is none
+//   random_roomy_cell(rng, row, col)
+//                          an empty cell with ROOMY_NEIGHBOURS empty neighbours,
+//                          false if none was found
+//   reserve_for_robots(robots)
+//                          with obstacles and robots placed: allocate whatever
+//                          robots moving about can need, so a turn never does
+//
+// FlatBoard and FixedBoard (here) store every cell and suit ordinary arenas;
+// TiledBoard (TiledBoard.h) only stores the parts of a huge arena that hold
+// something.
+
+// The arena grid as one contiguous row-major buffer.
+//
+// The playing field is surrounded by a one-cell ring of WALL cells, so every
+// cell at row -1..rows and col -1..cols can be read without a bounds check.
+// Radar rays come from a RadarTable of flat-index offsets; side cells that
+// fall off the field read WALL.
+//
+// Every write goes through set(), which also keeps one BitBoard per cell kind
+// (plus BLOCKERS and OCCUPIED) in sync, so area and along-a-row queries can be
+// answered a word at a time. Live robots and blockers are also kept as
+// LineBitBoards for "nearest one in this direction" queries along any of the
+// eight directions.
+//
+// Cells holding a live robot also record which robot it is in a parallel
+// robot-id grid, so finding the robot on a cell is one array load no matter
+// what symbol it is displayed with.
+//
+// The empty cells are kept as a CellSet with the roomy ones marked (and each
+// cell's count of empty neighbours), so a uniformly random empty or roomy
+// cell is a single draw however full the board is.
+//
+// Dims (BoardDims.h) is the size policy: FlatBoard takes its size at run
+// time, FixedBoard<Rows, Cols> has it fixed at compile time, which makes the
+// stride and bounds constants and keeps every buffer (bitsets and cell sets
+// included) inside the board object. Only the shared radar tables are not.
+template <typename Dims>
+class BasicFlatBoard {
+private:
+    static constexpr size_t CELLS = fixed_size<Dims>((size_t)(Dims::ROWS + 2) * (Dims::COLS + 2));
+    static constexpr size_t FIELD = fixed_size<Dims>((size_t)Dims::ROWS * Dims::COLS);
+
+    [[no_unique_address]] Dims m_dims;
+
+    BoardStorage<char, CELLS> m_cells;
+    BoardStorage<uint16_t, CELLS> m_robot_ids;      // robot index + 1 per cell, 0 if no live robot
+    BasicBitBoard<Dims> m_layers[LAYER_COUNT];
+    BasicLineBitBoard<Dims> m_live_lines;
+    BasicLineBitBoard<Dims> m_blocker_lines;
+    const RadarTable& m_radar;                      // shared ray tables for this board size
+
+    BasicCellSet<CELLS, FIELD> m_free;              // empty cells, marked if roomy
+    BoardStorage<uint8_t, CELLS> m_open;            // empty neighbours per cell
+
+    void set_layers(int row, int col, bool present);
+    void set_free(int index, bool free);
+    void update_roomy(int index) { m_free.mark(index, m_open[index] >= ROOMY_NEIGHBOURS); }
+
+    // The cell in a uniformly random one of the first count slots of m_free
+    bool random_cell(int count, GameRng& rng, int& row, int& col) const
+    {
+        if (count == 0) {
+            return false;
+        }
+        int i = m_free[rng.below(count)];
+        row = row_of(i);
+        col = col_of(i);
+        return true;
+    }
+
+public:
+    BasicFlatBoard(int rows = Dims::ROWS, int cols = Dims::COLS);
+
+    int rows() const { return m_dims.rows(); }
+    int cols() const { return m_dims.cols(); }
+    int stride() const { return m_dims.cols() + 2; }   // cells per stored row: cols plus the two ring columns
+
+    // Flat index of (row, col); valid for the ring cells as well
+    int index(int row, int col) const { return (row + 1) * stride() + (col + 1); }
+    int row_of(int index) const { return index / stride() - 1; }
+    int col_of(int index) const { return index % stride() - 1; }
+
+    // Index offset of one step in a directions[] direction
+    int step(int dr, int dc) const { return dr * stride() + dc; }
+
+    char operator[](int index) const { return m_cells[index]; }
+    char at(int row, int col) const { return m_cells[index(row, col)]; }
+
+    const BasicBitBoard<Dims>& layer(BoardLayer layer) const { return m_layers[layer]; }
+
+    // Robot index on a cell (valid for the ring cells as well), or -1
+    int robot_at(int row, int col) const { return m_robot_ids[index(row, col)] - 1; }
+
+    void set(int row, int col, char cell);
+    void set_robot(int row, int col, char symbol, int robot_index);
+
+    bool is_valid_position(int row, int col) const
+    {
+        return (unsigned)row < (unsigned)rows() && (unsigned)col < (unsigned)cols();
+    }
+
+    bool is_blocked(int row, int col) const { return m_layers[BLOCKERS].test(row, col); }
+    int nearest_blocker(int row, int col, int dr, int dc) const { return m_blocker_lines.nearest(row, col, dr, dc); }
+    int nearest_robot(int row, int col, int dr, int dc) const { return m_live_lines.nearest(row, col, dr, dc); }
+
+    bool any_robot_in_rect(int r0, int c0, int r1, int c1) const
+    {
+        return m_layers[LIVE_ROBOTS].any_in_rect(r0, c0, r1, c1);
+    }
+
+    template <typename Visit>
+    void for_each_robot_in_rect(int r0, int c0, int r1, int c1, Visit visit) const
+    {
+        m_layers[LIVE_ROBOTS].for_each_in_rect(r0, c0, r1, c1, visit);
+    }
+
+    void scan_radar(int row, int col, int direction, std::vector<RadarObj>& results) const;
+    int max_radar_cells() const { return m_radar.max_cells(); }
+
+    bool random_free_cell(GameRng& rng, int& row, int& col) const { return random_cell(m_free.size(), rng, row, col); }
+    bool random_roomy_cell(GameRng& rng, int& row, int& col) const { return random_cell(m_free.marked(), rng, row, col); }
+
+    // Every buffer is sized by the constructor
+    void reserve_for_robots(int) {}
+
+    void clear();
+};
+
+// The board size games are played on unless --size says otherwise
+constexpr int STANDARD_ROWS = 20;
+constexpr int STANDARD_COLS = 20;
+
+using FlatBoard = BasicFlatBoard<RuntimeDims>;
+template <int Rows, int Cols>
+using FixedBoard = BasicFlatBoard<BoardDims<Rows, Cols>>;
+
+// Both are instantiated in Board.cpp; another fixed size needs a line there
+extern template class BasicFlatBoard<RuntimeDims>;
+extern template class BasicFlatBoard<BoardDims<STANDARD_ROWS, STANDARD_COLS>>;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+
+// Size policy for the flat board storages (Board.h) and the bitsets and cell
+// sets they are built from.
+//
+// BoardDims<Rows, Cols> fixes the size at compile time: rows() and cols() are
+// constants, so strides and bounds fold into the addressing, and every buffer
+// sized from them is a std::array inside the object. BoardDims<> (RuntimeDims)
+// holds a size given at run time and its buffers are std::vectors. Code that
+// takes a Dims is written once for both.
+constexpr int RUNTIME_SIZE = 0;
+
+template <int Rows = RUNTIME_SIZE, int Cols = RUNTIME_SIZE>
+class BoardDims {
+public:
+    static constexpr bool FIXED = true;
+    static constexpr int ROWS = Rows;
+    static constexpr int COLS = Cols;
+
+    // Takes (rows, cols) like RuntimeDims so both construct alike; they must be Rows and Cols
+    constexpr BoardDims(int = Rows, int = Cols) {}
+
+    static constexpr int rows() { return Rows; }
+    static constexpr int cols() { return Cols; }
+
+    // The same board turned on its side, and one row per diagonal (see LineBitBoard)
+    using Transposed = BoardDims<Cols, Rows>;
+    using Diagonals = BoardDims<Rows + Cols - 1, Rows>;
+};
+
+template <>
+class BoardDims<RUNTIME_SIZE, RUNTIME_SIZE> {
+private:
+    int m_rows;
+    int m_cols;
+
+public:
+    static constexpr bool FIXED = false;
+    static constexpr int ROWS = RUNTIME_SIZE;
+    static constexpr int COLS = RUNTIME_SIZE;
+
+    BoardDims(int rows = 0, int cols = 0) : m_rows(rows), m_cols(cols) {}
+
+    int rows() const { return m_rows; }
+    int cols() const { return m_cols; }
+
+    using Transposed = BoardDims;
+    using Diagonals = BoardDims;
+};
+
+using RuntimeDims = BoardDims<>;
+
+// Size of a buffer of a fixed-size board; 0 for a runtime-sized one
+template <typename Dims>
+constexpr size_t fixed_size(size_t size) { return Dims::FIXED ? size : 0; }
+
+// Size elements inside the object, or a std::vector when Size is 0
+template <typename T, size_t Size>
+using BoardStorage = std::conditional_t<Size == 0, std::vector<T>, std::array<T, Size>>;
+
+// Gives a vector its run-time size; an array already has it
+template <typename T>
+void size_storage(std::vector<T>& storage, size_t size) { storage.assign(size, T()); }
+
+template <typename T, size_t Size>
+void size_storage(std::array<T, Size>&, size_t) {}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include "BoardDims.h"
+
+// A set of cell indices with O(1) insert, erase and uniform random pick, and
+// a marked subset that can be picked from just as cheaply: the members in no
+// particular order except that the marked ones come first, plus each index's
+// slot in that list. One list serves both sets, so a board pays for a single
+// index however many of its cells are marked.
+// Storage for every possible member is set aside up front, so changing the
+// set never allocates. With a non-zero Capacity and MaxSize both lists are
+// arrays inside the set; otherwise the constructor sizes them.
+template <size_t Capacity = 0, size_t MaxSize = 0>
+class BasicCellSet {
+private:
+    BoardStorage<int, MaxSize> m_items;
+    BoardStorage<int, Capacity> m_slots;    // per index: its slot in m_items, -1 if absent
+    int m_size;
+    int m_marked;                           // members in slots 0..m_marked-1 are marked
+
+    // Exchanges the members in two slots
+    void swap_slots(int a, int b)
+    {
+        std::swap(m_items[a], m_items[b]);
+        m_slots[m_items[a]] = a;
+        m_slots[m_items[b]] = b;
+    }
+
+public:
+    // Room for indices 0..capacity-1, at most max_size of them at once
+    BasicCellSet(int capacity = Capacity, int max_size = MaxSize) : m_size(0), m_marked(0)
+    {
+        size_storage(m_items, max_size);
+        size_storage(m_slots, capacity);
+        std::fill(m_slots.begin(), m_slots.end(), -1);
+    }
+
+    int size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    int marked() const { return m_marked; }
+    bool contains(int index) const { return m_slots[index] >= 0; }
+    bool is_marked(int index) const { return (unsigned)m_slots[index] < (unsigned)m_marked; }
+
+    // Slots 0..marked()-1 hold the marked members, the rest follow up to size()
+    int operator[](int slot) const { return m_items[slot]; }
+
+    void clear()
+    {
+        m_size = 0;
+        m_marked = 0;
+        std::fill(m_slots.begin(), m_slots.end(), -1);
+    }
+
+    // New members start unmarked
+    void insert(int index)
+    {
+        if (m_slots[index] < 0) {
+            m_slots[index] = m_size;
+            m_items[m_size++] = index;
+        }
+    }
+
+    // Moves the last member into the freed slot
+    void erase(int index)
+    {
+        if (m_slots[index] < 0) {
+            return;
+        }
+        mark(index, false);
+        swap_slots(m_slots[index], m_size - 1);
+        m_size--;
+        m_slots[index] = -1;
+    }
+
+    void set(int index, bool member)
+    {
+        if (member) {
+            insert(index);
+        } else {
+            erase(index);
+        }
+    }
+
+    // Marks or unmarks a member by swapping it across the marked boundary;
+    // indices that are not members are left alone
+    void mark(int index, bool marked)
+    {
+        int slot = m_slots[index];
+        if (slot < 0 || (slot < m_marked) == marked) {
+            return;
+        }
+        if (marked) {
+            swap_slots(slot, m_marked++);
+        } else {
+            swap_slots(slot, --m_marked);
+        }
+    }
+};
+
+using CellSet = BasicCellSet<>;
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+// The arena's random number generator: one per game, keyed by the run's seed
+// and the game's number.
+//
+// Counter based: draw n is a hash of (key, n), so the generator is two words,
+// costs nothing to set up, and games numbered differently get unrelated
+// streams no matter which thread or process plays them. The same (seed, game)
+// always replays the same obstacles, placements and teleports.
+class GameRng {
+private:
+    uint64_t m_key;
+    uint64_t m_counter;
+
+    // SplitMix64 finalizer: a bijection that scrambles every input bit
+    static uint64_t mix(uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+public:
+    using result_type = uint64_t;
+
+    GameRng(uint64_t seed = 0, uint64_t game = 0) { reseed(seed, game); }
+
+    void reseed(uint64_t seed, uint64_t game)
+    {
+        m_key = mix(seed ^ mix(game + 0x9E3779B97F4A7C15ULL));
+        m_counter = 0;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~0ULL; }
+
+    result_type operator()() { return mix(m_key ^ mix(++m_counter)); }
+
+    // Uniform in [0, n) for n >= 1 (multiply-shift, no division)
+    int below(int n) { return (int)(((*this)() >> 32) * (uint64_t)n >> 32); }
+
+    // Uniform in [lo, hi]
+    int uniform(int lo, int hi) { return lo + below(hi - lo + 1); }
+};
@@ -0,0 +1,72 @@
+#include "NamespacePool.h"
+#include <algorithm>
+
+// ===== CONSTRUCTOR/DESTRUCTOR =====
+
+NamespacePool::NamespacePool()
+    : m_count(0)
+{
+}
+
+NamespacePool::~NamespacePool()
+{
+    // Every robot library must already be closed; dropping the anchors lets
+    // glibc tear the namespaces down
+    for (void* anchor : m_anchors) {
+        dlclose(anchor);
+    }
+}
+
+// ===== POOL MANAGEMENT =====
+
+bool NamespacePool::create_namespace()
+{
+    void* anchor = dlmopen(LM_ID_NEWLM, "libstdc++.so.6", RTLD_NOW | RTLD_LOCAL);
+    if (!anchor) {
+        return false;
+    }
+
+    Lmid_t lmid;
+    if (dlinfo(anchor, RTLD_DI_LMID, &lmid) != 0) {
+        dlclose(anchor);
+        return false;
+    }
+
+    m_anchors.push_back(anchor);
+
+    // Keep the shared RobotBase library resident as well, so robot libraries only
+    // map themselves when they are loaded into this namespace
+    void* robot_base = dlmopen(lmid, "./libRobotBase.so", RTLD_NOW | RTLD_LOCAL);
+    if (robot_base) {
+        m_anchors.push_back(robot_base);
+    }
+
+    m_free.push_back(lmid);
+    m_count++;
+    return true;
+}
+
+int NamespacePool::reserve(int count)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (m_count < count && create_namespace()) {
+    }
+    return std::min(count, m_count);
+}
+
+bool NamespacePool::acquire(Lmid_t& lmid)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_free.empty() && !create_namespace()) {
+        return false;
+    }
+    lmid = m_free.back();
+    m_free.pop_back();
+    return true;
+}
+
+void NamespacePool::release(Lmid_t lmid)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(lmid);
+}
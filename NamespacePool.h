@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <dlfcn.h>
+
+// Pool of private dynamic-linker namespaces (dlmopen link maps).
+//
+// Robots loaded into a namespace get their own copy of every global and
+// function-local static, so concurrent games cannot see each other's state.
+// Creating a namespace means loading libc/libstdc++ into it, which is the
+// expensive part; each namespace keeps an "anchor" handle to libstdc++ open so
+// it survives between games and only the small robot libraries are mapped and
+// unmapped per game.
+//
+// glibc supports a limited number of namespaces (16 link maps, and in practice
+// fewer because each one needs static TLS; raise it with
+// GLIBC_TUNABLES=glibc.rtld.nns=<n>), so callers should reserve() up front and
+// size their worker pool to the result.
+class NamespacePool {
+private:
+    std::mutex m_mutex;
+    std::vector<void*> m_anchors;
+    int m_count;   // namespaces created so far
+    std::vector<Lmid_t> m_free;
+
+    bool create_namespace();
+
+public:
+    NamespacePool();
+    ~NamespacePool();
+
+    NamespacePool(const NamespacePool&) = delete;
+    NamespacePool& operator=(const NamespacePool&) = delete;
+
+    int reserve(int count);
+    bool acquire(Lmid_t& lmid);
+    void release(Lmid_t lmid);
+};
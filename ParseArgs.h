@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+
+// Strict command line number parsing for RobotWarz and its benchmarks.
+//
+// Each parse takes the whole string or nothing: a false return (on junk,
+// trailing characters, overflow or a value out of range) means the caller
+// prints its usage and exits.
+
+// Whole-string decimal parse; false on junk, overflow or a value below min
+inline bool parse_int(const char* text, int min, int& value)
+{
+    char* end;
+    errno = 0;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < min || parsed > INT_MAX) {
+        return false;
+    }
+    value = (int)parsed;
+    return true;
+}
+
+// Whole-string unsigned 64-bit parse; strtoull would wrap a leading '-'
+inline bool parse_seed(const char* text, uint64_t& value)
+{
+    char* end;
+    errno = 0;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || text[0] == '-') {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
@@ -0,0 +1,64 @@
+#include "RadarTable.h"
+#include "RobotBase.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+
+RadarTable::RadarTable(int rows, int cols)
+    : m_rows(rows), m_cols(cols)
+{
+    int stride = cols + 2;  // matches FlatBoard's layout, ring columns included
+    int max_steps = std::max(rows, cols) + 1;
+
+    // Direction 0: the 8 neighbours, in direction order
+    m_ray_start[0] = 0;
+    for (int direction = 1; direction <= 8; direction++) {
+        m_offsets.push_back(directions[direction].first * stride + directions[direction].second);
+    }
+    for (int direction = 1; direction <= 8; direction++) {
+        m_ray_start[direction] = (int)m_offsets.size();
+        for (int k = 0; k < 3 * max_steps; k++) {
+            int dr, dc;
+            cell(direction, k, dr, dc);
+            m_offsets.push_back(dr * stride + dc);
+        }
+    }
+}
+
+int RadarTable::ray_steps(int rows, int cols, int row, int col, int direction)
+{
+    auto [dr, dc] = directions[direction];
+    int to_row_edge = dr > 0 ? rows - 1 - row : row;
+    int to_col_edge = dc > 0 ? cols - 1 - col : col;
+
+    // A straight ray ends with its centre. A diagonal one lasts one step more
+    // when the edges are at different distances, since a side cell is still
+    // running along the nearer edge.
+    if (dr == 0) {
+        return to_col_edge;
+    }
+    if (dc == 0) {
+        return to_row_edge;
+    }
+    return std::min(to_row_edge, to_col_edge) + (to_row_edge != to_col_edge ? 1 : 0);
+}
+
+int RadarTable::max_cells() const
+{
+    return 3 * (std::max(m_rows, m_cols) + 1);
+}
+
+const RadarTable& RadarTable::for_size(int rows, int cols)
+{
+    // Built once per board size and shared by every arena (and thread) using it
+    static std::mutex mutex;
+    static std::map<std::pair<int, int>, std::unique_ptr<RadarTable>> tables;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& table = tables[{rows, cols}];
+    if (!table) {
+        table = std::make_unique<RadarTable>(rows, cols);
+    }
+    return *table;
+}
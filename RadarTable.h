@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include "RobotBase.h"
+
+// Precomputed radar rays for one board size.
+//
+// Direction 0 is the ring of 8 neighbours. Directions 1-8 are a ray 3 cells
+// wide running from the robot to the edge of the arena. Every direction keeps one
+// list of flat-index offsets, nearest cells first; how many of them a scan from
+// a given position reads follows from its distance to the edges.
+// Off-board cells on the ray's sides land in the FlatBoard's WALL ring, so a
+// scan just reads count cells from the origin without any bounds checks.
+class RadarTable {
+private:
+    int m_rows;
+    int m_cols;
+
+    std::vector<int> m_offsets;         // all directions' offset lists, back to back
+    int m_ray_start[9];                 // first offset of each direction
+
+public:
+    RadarTable(int rows, int cols);
+
+    static const RadarTable& for_size(int rows, int cols);
+
+    // Cell k of a direction 1-8 ray, as a (row, col) offset from the robot: the
+    // centre of step k / 3 + 1 first, then its two sides
+    static constexpr void cell(int direction, int k, int& dr, int& dc)
+    {
+        // Straight rays widen perpendicular to the direction; diagonal rays take
+        // the two cells flanking the diagonal step, so the band has no gaps
+        auto [step_r, step_c] = directions[direction];
+        int dist = k / 3 + 1;
+        int side = k % 3;
+        dr = step_r * dist;
+        dc = step_c * dist;
+        if (side == 0) {
+            return;
+        }
+        if (step_r != 0 && step_c != 0) {
+            if (side == 1) {
+                dc -= step_c;
+            } else {
+                dr -= step_r;
+            }
+        } else {
+            int sign = (side == 1) ? 1 : -1;
+            dr += step_c * sign;
+            dc += step_r * sign;
+        }
+    }
+
+    // Steps a direction 1-8 ray from (row, col) lasts before none of its three
+    // cells is on a rows x cols board
+    static int ray_steps(int rows, int cols, int row, int col, int direction);
+
+    // Longest ray any position can produce, in cells
+    int max_cells() const;
+
+    // Offsets for a scan from (row, col) in direction 0-8; sets count
+    const int* ray(int row, int col, int direction, int& count) const
+    {
+        count = direction == 0 ? 8 : 3 * ray_steps(m_rows, m_cols, row, col, direction);
+        return &m_offsets[m_ray_start[direction]];
+    }
+};
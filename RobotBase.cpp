@@ -140,6 +140,12 @@ void RobotBase::disable_movement()
     m_move = 0;
 }
 
+// Give the robot its movement back (the arena passes the speed it was built with)
+void RobotBase::enable_movement(int move_in)
+{
+    m_move = move_in;
+}
+
 void RobotBase::reduce_armor(int amount)
 {
     m_armor = m_armor - amount;
@@ -174,4 +180,10 @@ std::string RobotBase::print_stats() const {
 RobotBase::~RobotBase()
 {
     // No additional cleanup required
-}
\ No newline at end of file
+}
+
+// Looked up with dlsym by Arena::name_robot so m_name is set in the robot's own namespace
+extern "C" void set_robot_name(RobotBase* robot, const char* name)
+{
+    robot->m_name = name;
+}
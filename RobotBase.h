@@ -59,6 +59,7 @@ public:
     virtual int take_damage(int damage_in) final;
     virtual void move_to(int new_row, int new_col) final;
     virtual void disable_movement() final;
+    virtual void enable_movement(int move_in) final;
     virtual void reduce_armor(int amount) final;
     virtual void decrement_grenades() final;
     virtual std::string print_stats() const  final;
@@ -77,4 +78,7 @@ public:
 // to aid in the creation of the robots as shared objects.
 typedef RobotBase* (*RobotFactory)();
 
+// Defined in libRobotBase.so; Arena::name_robot looks it up with dlsym
+extern "C" void set_robot_name(RobotBase* robot, const char* name);
+
 
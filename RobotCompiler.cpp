@@ -0,0 +1,239 @@
+#include "RobotCompiler.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Arena-side headers every robot library is built against. RobotBase.cpp itself
+// lives in libRobotBase.so, so changing it does not invalidate cached robots.
+static const char* const SHARED_SOURCES[] = { "RobotBase.h", "RadarObj.h" };
+
+// FNV-1a, 64 bit - plenty for telling a handful of source revisions apart
+static void hash_bytes(uint64_t& hash, const char* data, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+static bool hash_file(uint64_t& hash, const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    const std::string& data = contents.str();
+    hash_bytes(hash, data.data(), data.size());
+    return true;
+}
+
+// ===== CONSTRUCTOR =====
+
+RobotCompiler::RobotCompiler(const std::string& directory)
+    : m_directory(directory), m_cache_dir(".robot_cache"), m_verbose(true), m_profile(BuildProfile::release)
+{
+    m_jobs = std::max(1u, std::thread::hardware_concurrency());
+}
+
+void RobotCompiler::set_jobs(int jobs)
+{
+    m_jobs = std::max(1, jobs);
+}
+
+void RobotCompiler::set_verbose(bool verbose)
+{
+    m_verbose = verbose;
+}
+
+void RobotCompiler::set_profile(BuildProfile profile)
+{
+    m_profile = profile;
+}
+
+bool RobotCompiler::parse_profile(const std::string& name, BuildProfile& profile)
+{
+    if (name == "debug") {
+        profile = BuildProfile::debug;
+    } else if (name == "release") {
+        profile = BuildProfile::release;
+    } else if (name == "lto") {
+        profile = BuildProfile::lto;
+    } else if (name == "pgo-generate") {
+        profile = BuildProfile::pgo_generate;
+    } else if (name == "pgo-use") {
+        profile = BuildProfile::pgo_use;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// ===== SOURCES =====
+
+std::vector<std::string> RobotCompiler::find_sources(const std::string& directory)
+{
+    // Robot_*.cpp files, sorted so robots load in the same order on every run
+    std::vector<std::string> filenames;
+    for (const auto& entry : fs::directory_iterator(directory)) {
+        std::string filename = entry.path().filename().string();
+        if (filename.find("Robot_") == 0 && filename.ends_with(".cpp")) {
+            filenames.push_back(filename);
+        }
+    }
+    std::sort(filenames.begin(), filenames.end());
+    return filenames;
+}
+
+std::string RobotCompiler::robot_name(const std::string& cpp_filename)
+{
+    // Remove Robot_ prefix and .cpp suffix
+    return cpp_filename.substr(6, cpp_filename.length() - 10);
+}
+
+// ===== CACHE =====
+
+std::string RobotCompiler::profile_data(const std::string& cpp_filename) const
+{
+    // -dumpdir/-dumpbase pin the profile file name, so instrumented and
+    // optimized builds agree on it even though their output files differ
+    return m_cache_dir + "/pgo/" + robot_name(cpp_filename) + ".gcda";
+}
+
+std::string RobotCompiler::profile_flags(const std::string& cpp_filename) const
+{
+    std::string profile_names = " -dumpdir " + m_cache_dir + "/pgo/ -dumpbase " + robot_name(cpp_filename);
+
+    switch (m_profile) {
+        case BuildProfile::debug:
+            return "-O0 -g";
+        case BuildProfile::release:
+            return "-O2";
+        case BuildProfile::lto:
+            return "-O2 -flto";
+        case BuildProfile::pgo_generate:
+            return "-O2 -fprofile-generate -fprofile-update=atomic" + profile_names;
+        case BuildProfile::pgo_use:
+            return "-O2 -fprofile-use -fprofile-correction -Wno-missing-profile" + profile_names;
+    }
+    return "";
+}
+
+std::string RobotCompiler::compile_command(const std::string& cpp_filename, const std::string& output) const
+{
+    // -fno-gnu-unique keeps function-local statics in inline member functions out
+    // of the global unique-symbol table, which would otherwise pin the library in
+    // memory so dlclose never resets its state.
+    //
+    // Robots link the shared libRobotBase.so built by the Makefile rather than
+    // compiling their own RobotBase.cpp; the rpath points from the cache
+    // directory back to it for namespaces that load it fresh.
+    return "g++ -shared -fPIC -fno-gnu-unique -std=c++20 " + profile_flags(cpp_filename) + " -I. -o " + output + " " +
+           m_directory + "/" + cpp_filename + " -L. -lRobotBase -Wl,-rpath,'$ORIGIN/..'";
+}
+
+std::string RobotCompiler::cache_key(const std::string& cpp_filename) const
+{
+    uint64_t hash = 14695981039346656037ULL;
+    if (!hash_file(hash, m_directory + "/" + cpp_filename)) {
+        return "";
+    }
+    for (const char* shared : SHARED_SOURCES) {
+        hash_file(hash, shared);
+    }
+    std::string command = compile_command(cpp_filename, "");
+    hash_bytes(hash, command.data(), command.size());
+
+    // A new training run must produce a new optimized library
+    if (m_profile == BuildProfile::pgo_use) {
+        hash_file(hash, profile_data(cpp_filename));
+    }
+
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return key.str();
+}
+
+std::string RobotCompiler::library_path(const std::string& cpp_filename)
+{
+    auto it = m_library_paths.find(cpp_filename);
+    if (it != m_library_paths.end()) {
+        return it->second;
+    }
+
+    std::string key = cache_key(cpp_filename);
+    std::string path = key.empty() ? "" : m_cache_dir + "/lib" + robot_name(cpp_filename) + "-" + key + ".so";
+    m_library_paths[cpp_filename] = path;
+    return path;
+}
+
+// ===== BUILD =====
+
+std::vector<std::string> RobotCompiler::build(const std::vector<std::string>& cpp_filenames)
+{
+    std::error_code error;
+    fs::create_directories(m_cache_dir + "/pgo", error);
+
+    // Only robots without a library for their current key need compiling
+    std::vector<std::string> stale;
+    std::vector<std::string> targets;
+    for (const auto& filename : cpp_filenames) {
+        std::string path = library_path(filename);
+        if (path.empty()) {
+            std::cerr << "Cannot read " << m_directory << "/" << filename << std::endl;
+        } else if (!fs::exists(path)) {
+            stale.push_back(filename);
+            targets.push_back(path);
+        }
+    }
+
+    // Compile stale robots concurrently, at most m_jobs at a time. Each build
+    // writes a private temporary file and renames it into place, so concurrent
+    // arenas sharing the cache never see a half-written library.
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < stale.size(); i = next++) {
+            std::string temporary = targets[i] + ".tmp" + std::to_string(getpid()) + "_" + std::to_string(i);
+
+            if (m_verbose) {
+                std::cout << ("Compiling " + stale[i] + " to " + targets[i] + "...\n") << std::flush;
+            }
+
+            int result = std::system(compile_command(stale[i], temporary).c_str());
+            if (result != 0 || std::rename(temporary.c_str(), targets[i].c_str()) != 0) {
+                std::remove(temporary.c_str());
+                std::cerr << ("Failed to compile " + stale[i] + "\n");
+            }
+        }
+    };
+
+    int jobs = std::min<int>(m_jobs, stale.size());
+    std::vector<std::thread> workers;
+    for (int i = 1; i < jobs; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    std::vector<std::string> built;
+    for (const auto& filename : cpp_filenames) {
+        std::string path = library_path(filename);
+        if (!path.empty() && fs::exists(path)) {
+            built.push_back(filename);
+        }
+    }
+    return built;
+}
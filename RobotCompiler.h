@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+
+// Optimization settings robot libraries are compiled with
+enum class BuildProfile {
+    debug,          // -O0 -g
+    release,        // -O2
+    lto,            // -O2 -flto
+    pgo_generate,   // -O2, instrumented to record a profile while games run
+    pgo_use         // -O2, optimized with the recorded profile
+};
+
+// Builds Robot_*.cpp sources into shared libraries.
+//
+// Libraries are cached by content: the file name includes a hash of the robot
+// source, the RobotBase/RadarObj sources it is compiled against and the compile
+// command, so an unchanged robot is never rebuilt and a stale one can never be
+// loaded by mistake. Robots that do need a build are compiled concurrently.
+class RobotCompiler {
+private:
+    std::string m_directory;
+    std::string m_cache_dir;
+    int m_jobs;
+    bool m_verbose;
+    BuildProfile m_profile;
+
+    std::map<std::string, std::string> m_library_paths;  // source -> cached library
+
+    std::string profile_flags(const std::string& cpp_filename) const;
+    std::string profile_data(const std::string& cpp_filename) const;
+    std::string compile_command(const std::string& cpp_filename, const std::string& output) const;
+    std::string cache_key(const std::string& cpp_filename) const;
+
+public:
+    RobotCompiler(const std::string& directory = ".");
+
+    void set_jobs(int jobs);
+    void set_verbose(bool verbose);
+    void set_profile(BuildProfile profile);
+
+    static bool parse_profile(const std::string& name, BuildProfile& profile);
+
+    static std::vector<std::string> find_sources(const std::string& directory = ".");
+    static std::string robot_name(const std::string& cpp_filename);
+
+    std::vector<std::string> build(const std::vector<std::string>& cpp_filenames);
+    std::string library_path(const std::string& cpp_filename);
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "RobotBase.h"
+
+// The robot fields the arena reads every turn, one array per field, indexed
+// like the arena's robots.
+//
+// RobotBase keeps these private behind getters that live in libRobotBase.so,
+// and only the arena calls the setters that change them (move_to, take_damage,
+// reduce_armor, disable_movement, enable_movement, decrement_grenades). So the
+// arena mirrors each change here as it makes it, and the turn loop reads the
+// arrays instead of calling into the library.
+struct RobotState {
+    std::vector<int> row;
+    std::vector<int> col;
+    std::vector<int> health;
+    std::vector<int> armor;
+    std::vector<int> move;
+    std::vector<int> grenades;
+    std::vector<WeaponType> weapon;
+    std::vector<uint8_t> alive;
+    std::vector<uint8_t> in_pit;
+
+    size_t size() const { return row.size(); }
+
+    // Appends a robot as RobotBase currently has it, alive and not in a pit
+    void push_back(RobotBase& robot)
+    {
+        int r, c;
+        robot.get_current_location(r, c);
+        row.push_back(r);
+        col.push_back(c);
+        health.push_back(robot.get_health());
+        armor.push_back(robot.get_armor());
+        move.push_back(robot.get_move_speed());
+        grenades.push_back(robot.get_grenades());
+        weapon.push_back(robot.get_weapon());
+        alive.push_back(1);
+        in_pit.push_back(0);
+    }
+
+    void pop_back()
+    {
+        row.pop_back();
+        col.pop_back();
+        health.pop_back();
+        armor.pop_back();
+        move.pop_back();
+        grenades.pop_back();
+        weapon.pop_back();
+        alive.pop_back();
+        in_pit.pop_back();
+    }
+
+    void clear()
+    {
+        row.clear();
+        col.clear();
+        health.clear();
+        armor.clear();
+        move.clear();
+        grenades.clear();
+        weapon.clear();
+        alive.clear();
+        in_pit.clear();
+    }
+};
@@ -0,0 +1,346 @@
+#include "TiledBoard.h"
+#include "RadarTable.h"
+#include "RobotBase.h"
+#include <climits>
+
+void TiledBoard::Tile::reset()
+{
+    std::fill(std::begin(cells), std::end(cells), (char)EMPTY);
+    std::fill(std::begin(robot_ids), std::end(robot_ids), 0);
+    for (auto& layer : bits) {
+        std::fill(std::begin(layer), std::end(layer), 0);
+    }
+    std::fill(std::begin(counts), std::end(counts), 0);
+}
+
+TiledBoard::TiledBoard(int rows, int cols)
+    : m_rows(rows), m_cols(cols),
+      m_tile_rows((rows + TILE - 1) / TILE), m_tile_cols((cols + TILE - 1) / TILE)
+{
+    m_tiles.resize((size_t)m_tile_rows * m_tile_cols);
+}
+
+const TiledBoard::Tile& TiledBoard::empty_tile()
+{
+    static const Tile tile;
+    return tile;
+}
+
+void TiledBoard::clear()
+{
+    for (auto& tile : m_tiles) {
+        if (tile) {
+            tile->reset();
+            m_spare.push_back(std::move(tile));
+        }
+    }
+}
+
+// Tiles never move, and a robot is on one cell at a time, so at most the
+// tiles holding obstacles plus one per robot are ever in use at once; dead
+// robots stay in the tile they died in. Whatever the board does not hold now
+// goes into the spare pool, and the pool gets room to take every tile back.
+void TiledBoard::reserve_for_robots(int robots)
+{
+    int held = 0;
+    int fixed = 0;      // tiles with something other than a live robot
+    for (const auto& tile : m_tiles) {
+        if (tile) {
+            held++;
+            if (tile->counts[OCCUPIED] > tile->counts[LIVE_ROBOTS]) {
+                fixed++;
+            }
+        }
+    }
+
+    int pool = fixed + robots;
+    m_spare.reserve(pool);
+    while (held + (int)m_spare.size() < pool) {
+        m_spare.push_back(std::make_unique<Tile>());
+    }
+}
+
+// ===== WRITES =====
+
+TiledBoard::Tile& TiledBoard::writable_tile(int row, int col)
+{
+    std::unique_ptr<Tile>& tile = m_tiles[tile_index(row, col)];
+    if (!tile) {
+        if (!m_spare.empty()) {
+            tile = std::move(m_spare.back());
+            m_spare.pop_back();
+        } else {
+            tile = std::make_unique<Tile>();
+        }
+    }
+    return *tile;
+}
+
+void TiledBoard::set(int row, int col, char cell)
+{
+    write(row, col, cell, 0);
+}
+
+void TiledBoard::set_robot(int row, int col, char symbol, int robot_index)
+{
+    write(row, col, symbol, (uint16_t)(robot_index + 1));
+}
+
+void TiledBoard::write(int row, int col, char cell, uint16_t robot_id)
+{
+    std::unique_ptr<Tile>& slot = m_tiles[tile_index(row, col)];
+    if (!slot && cell == EMPTY) {
+        return;     // already empty, no need for a tile
+    }
+
+    Tile& tile = writable_tile(row, col);
+    int i = cell_index(row, col);
+    set_layers(tile, row, col, false);
+    tile.cells[i] = cell;
+    tile.robot_ids[i] = robot_id;
+    set_layers(tile, row, col, true);
+
+    // Last object gone: the tile is all EMPTY again, so the shared one will do
+    if (tile.counts[OCCUPIED] == 0) {
+        m_spare.push_back(std::move(slot));
+    }
+}
+
+void TiledBoard::set_layers(Tile& tile, int row, int col, bool present)
+{
+    int i = cell_index(row, col);
+    int kind = layer_of(tile.cells[i], tile.robot_ids[i] != 0);
+    if (kind < 0) {
+        return;
+    }
+
+    uint64_t bit = 1ULL << (col % TILE);
+    uint64_t* words[3] = { &tile.bits[kind][row % TILE], &tile.bits[OCCUPIED][row % TILE], nullptr };
+    int layers[3] = { kind, OCCUPIED, BLOCKERS };
+    if (layer_blocks(kind)) {
+        words[2] = &tile.bits[BLOCKERS][row % TILE];
+    }
+
+    for (int n = 0; n < 3 && words[n]; n++) {
+        if (present) {
+            *words[n] |= bit;
+            tile.counts[layers[n]]++;
+        } else {
+            *words[n] &= ~bit;
+            tile.counts[layers[n]]--;
+        }
+    }
+}
+
+// ===== QUERIES =====
+
+int TiledBoard::steps_in_tile(int row, int col, int dr, int dc)
+{
+    int steps = INT_MAX;
+    if (dr != 0) {
+        steps = dr > 0 ? TILE - row % TILE : row % TILE + 1;
+    }
+    if (dc != 0) {
+        steps = std::min(steps, dc > 0 ? TILE - col % TILE : col % TILE + 1);
+    }
+    return steps;
+}
+
+int TiledBoard::nearest(BoardLayer layer, int row, int col, int dr, int dc) const
+{
+    if (dr == 0 && dc == 0) {
+        return -1;
+    }
+
+    // Cells left before the edge
+    int limit = INT_MAX;
+    if (dr != 0) {
+        limit = dr > 0 ? m_rows - 1 - row : row;
+    }
+    if (dc != 0) {
+        limit = std::min(limit, dc > 0 ? m_cols - 1 - col : col);
+    }
+
+    // Walk the line one tile at a time, looking inside only the tiles that
+    // have something on this layer
+    int steps = 0;
+    while (steps < limit) {
+        int r = row + dr * (steps + 1);
+        int c = col + dc * (steps + 1);
+        int run = std::min(steps_in_tile(r, c, dr, dc), limit - steps);
+
+        const Tile* tile = m_tiles[tile_index(r, c)].get();
+        if (tile && tile->counts[layer] > 0) {
+            for (int i = 0; i < run; i++, r += dr, c += dc) {
+                if ((tile->bits[layer][r % TILE] >> (c % TILE)) & 1) {
+                    return steps + i + 1;
+                }
+            }
+        }
+        steps += run;
+    }
+    return -1;
+}
+
+bool TiledBoard::any_robot_in_rect(int r0, int c0, int r1, int c1) const
+{
+    r0 = std::max(r0, 0); r1 = std::min(r1, m_rows - 1);
+    c0 = std::max(c0, 0); c1 = std::min(c1, m_cols - 1);
+    if (r0 > r1 || c0 > c1) {
+        return false;
+    }
+    for (int tr = r0 / TILE; tr <= r1 / TILE; tr++) {
+        for (int tc = c0 / TILE; tc <= c1 / TILE; tc++) {
+            const Tile* tile = m_tiles[tr * m_tile_cols + tc].get();
+            if (!tile || tile->counts[LIVE_ROBOTS] == 0) {
+                continue;
+            }
+            int lo = std::max(c0 - tc * TILE, 0);
+            int hi = std::min(c1 - tc * TILE, TILE - 1);
+            uint64_t mask = (~0ULL >> (63 - hi)) & (~0ULL << lo);
+            for (int r = std::max(r0, tr * TILE); r <= std::min(r1, tr * TILE + TILE - 1); r++) {
+                if (tile->bits[LIVE_ROBOTS][r % TILE] & mask) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void TiledBoard::scan_radar(int row, int col, int direction, std::vector<RadarObj>& results) const
+{
+    if (direction == 0) {
+        for (int d = 1; d <= 8; d++) {
+            int r = row + directions[d].first;
+            int c = col + directions[d].second;
+            char cell = at(r, c);
+            if (cell != EMPTY && cell != WALL) {
+                results.emplace_back(cell, r, c);
+            }
+        }
+        return;
+    }
+
+    // Same cells in the same order as FlatBoard's RadarTable rays. While all
+    // three cells of a step sit in empty tiles (or off the field, where they
+    // stay), jump ahead to the first step where one of them changes tile.
+    auto [dr, dc] = directions[direction];
+    int steps = RadarTable::ray_steps(m_rows, m_cols, row, col, direction);
+    int step = 1;
+    while (step <= steps) {
+        int r[3], c[3];
+        bool occupied = false;
+        int jump = steps - step + 1;
+        for (int side = 0; side < 3; side++) {
+            RadarTable::cell(direction, (step - 1) * 3 + side, r[side], c[side]);
+            r[side] += row;
+            c[side] += col;
+            if (!is_valid_position(r[side], c[side])) {
+                continue;
+            }
+            if (m_tiles[tile_index(r[side], c[side])]) {
+                occupied = true;
+            }
+            jump = std::min(jump, steps_in_tile(r[side], c[side], dr, dc));
+        }
+
+        if (!occupied) {
+            step += jump;
+            continue;
+        }
+        for (int side = 0; side < 3; side++) {
+            char cell = at(r[side], c[side]);
+            if (cell != EMPTY && cell != WALL) {
+                results.emplace_back(cell, r[side], c[side]);
+            }
+        }
+        step++;
+    }
+}
+
+int TiledBoard::max_radar_cells() const
+{
+    return 3 * (std::max(m_rows, m_cols) + 1);
+}
+
+// ===== RANDOM CELLS =====
+
+int TiledBoard::open_neighbours(int row, int col) const
+{
+    int count = 0;
+    for (int dr = -1; dr <= 1; dr++) {
+        for (int dc = -1; dc <= 1; dc++) {
+            if ((dr != 0 || dc != 0) && at(row + dr, col + dc) == EMPTY) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+bool TiledBoard::random_free_cell(GameRng& rng, int& row, int& col) const
+{
+    for (int probe = 0; probe < RANDOM_PROBES; probe++) {
+        row = rng.below(m_rows);
+        col = rng.below(m_cols);
+        if (at(row, col) == EMPTY) {
+            return true;
+        }
+    }
+
+    // Nearly full: take the first tile from a random start that has room. An
+    // unallocated tile is all empty; otherwise look for a clear OCCUPIED bit.
+    long long tiles = (long long)m_tiles.size();
+    long long start = rng.below((int)std::min(tiles, (long long)INT_MAX));
+    for (long long k = 0; k < tiles; k++) {
+        long long t = (start + k) % tiles;
+        int r0 = (int)(t / m_tile_cols) * TILE;
+        int c0 = (int)(t % m_tile_cols) * TILE;
+        int height = std::min(TILE, m_rows - r0);
+        int width = std::min(TILE, m_cols - c0);
+        const Tile* tile = m_tiles[t].get();
+        if (!tile) {
+            row = r0 + rng.below(height);
+            col = c0 + rng.below(width);
+            return true;
+        }
+        if (tile->counts[OCCUPIED] == height * width) {
+            continue;
+        }
+        for (int r = 0; r < height; r++) {
+            uint64_t open = ~tile->bits[OCCUPIED][r] & (~0ULL >> (TILE - width));
+            if (open) {
+                row = r0 + r;
+                col = c0 + std::countr_zero(open);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool TiledBoard::random_roomy_cell(GameRng& rng, int& row, int& col) const
+{
+    for (int probe = 0; probe < RANDOM_PROBES; probe++) {
+        row = rng.below(m_rows);
+        col = rng.below(m_cols);
+        if (at(row, col) == EMPTY && open_neighbours(row, col) >= ROOMY_NEIGHBOURS) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ===== REPORTING =====
+
+int TiledBoard::allocated_tiles() const
+{
+    int count = 0;
+    for (const auto& tile : m_tiles) {
+        if (tile) {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include <bit>
+#include "Board.h"
+#include "RadarObj.h"
+
+// The arena grid as a directory of fixed-size tiles, for arenas far too big
+// to store cell by cell (10k x 10k and up).
+//
+// A tile is allocated the first time something is written into it and handed
+// back once its last object leaves; every other directory entry is null and
+// reads as the one shared, read-only empty tile. Memory therefore follows the
+// occupied area, not the arena area. Each tile keeps the same bit layers and
+// per-layer counts as FlatBoard, so rays and area queries jump over tiles
+// that hold nothing of the kind they are looking for.
+//
+// Implements the board interface described in Board.h. Cells off the field
+// read as WALL at any distance, so it never needs a sentinel ring. Keeping a
+// list of every empty cell would defeat the point, so random cells are drawn
+// by probing (a huge arena is nearly all empty), with a tile-by-tile search
+// as the fallback for random_free_cell.
+class TiledBoard {
+public:
+    static constexpr int TILE = 64;     // tile edge; one tile row is one bit word
+
+private:
+    struct Tile {
+        char cells[TILE * TILE];
+        uint16_t robot_ids[TILE * TILE];    // robot index + 1, 0 if no live robot
+        uint64_t bits[LAYER_COUNT][TILE];   // one word per tile row
+        int counts[LAYER_COUNT];            // set bits per layer
+
+        Tile() { reset(); }
+        void reset();
+    };
+
+    int m_rows;
+    int m_cols;
+    int m_tile_rows;
+    int m_tile_cols;
+
+    std::vector<std::unique_ptr<Tile>> m_tiles;     // null: the shared empty tile
+    std::vector<std::unique_ptr<Tile>> m_spare;     // emptied tiles kept for reuse
+
+    static const Tile& empty_tile();
+
+    int tile_index(int row, int col) const { return (row / TILE) * m_tile_cols + col / TILE; }
+    static int cell_index(int row, int col) { return (row % TILE) * TILE + col % TILE; }
+
+    const Tile& tile_at(int row, int col) const
+    {
+        const Tile* tile = m_tiles[tile_index(row, col)].get();
+        return tile ? *tile : empty_tile();
+    }
+
+    Tile& writable_tile(int row, int col);
+    void set_layers(Tile& tile, int row, int col, bool present);
+    void write(int row, int col, char cell, uint16_t robot_id);
+
+    // Steps to the first cell in direction (dr, dc) whose layer bit is set
+    int nearest(BoardLayer layer, int row, int col, int dr, int dc) const;
+
+    // Steps a cell moving by (dr, dc) stays inside its current tile
+    static int steps_in_tile(int row, int col, int dr, int dc);
+
+    // Random probes random_free_cell / random_roomy_cell make before giving up
+    static constexpr int RANDOM_PROBES = 64;
+
+    int open_neighbours(int row, int col) const;
+
+public:
+    TiledBoard(int rows, int cols);
+
+    TiledBoard(const TiledBoard&) = delete;
+    TiledBoard& operator=(const TiledBoard&) = delete;
+
+    int rows() const { return m_rows; }
+    int cols() const { return m_cols; }
+
+    bool is_valid_position(int row, int col) const
+    {
+        return row >= 0 && row < m_rows && col >= 0 && col < m_cols;
+    }
+
+    char at(int row, int col) const
+    {
+        return is_valid_position(row, col) ? tile_at(row, col).cells[cell_index(row, col)] : (char)WALL;
+    }
+
+    int robot_at(int row, int col) const
+    {
+        return is_valid_position(row, col) ? tile_at(row, col).robot_ids[cell_index(row, col)] - 1 : -1;
+    }
+
+    void set(int row, int col, char cell);
+    void set_robot(int row, int col, char symbol, int robot_index);
+
+    bool is_blocked(int row, int col) const
+    {
+        return is_valid_position(row, col) &&
+               ((tile_at(row, col).bits[BLOCKERS][row % TILE] >> (col % TILE)) & 1);
+    }
+
+    int nearest_blocker(int row, int col, int dr, int dc) const { return nearest(BLOCKERS, row, col, dr, dc); }
+    int nearest_robot(int row, int col, int dr, int dc) const { return nearest(LIVE_ROBOTS, row, col, dr, dc); }
+
+    bool any_robot_in_rect(int r0, int c0, int r1, int c1) const;
+
+    // Calls visit(row, col) for every live robot in the clipped rectangle, row
+    // by row. Each word is copied before it is visited, so visit may change the board.
+    template <typename Visit>
+    void for_each_robot_in_rect(int r0, int c0, int r1, int c1, Visit visit) const
+    {
+        r0 = std::max(r0, 0); r1 = std::min(r1, m_rows - 1);
+        c0 = std::max(c0, 0); c1 = std::min(c1, m_cols - 1);
+        if (c0 > c1) {
+            return;
+        }
+        for (int r = r0; r <= r1; r++) {
+            for (int tc = c0 / TILE; tc <= c1 / TILE; tc++) {
+                const Tile* tile = m_tiles[(r / TILE) * m_tile_cols + tc].get();
+                if (!tile || tile->counts[LIVE_ROBOTS] == 0) {
+                    continue;
+                }
+                int lo = std::max(c0 - tc * TILE, 0);
+                int hi = std::min(c1 - tc * TILE, TILE - 1);
+                uint64_t word = tile->bits[LIVE_ROBOTS][r % TILE] & (~0ULL >> (63 - hi)) & (~0ULL << lo);
+                while (word) {
+                    visit(r, tc * TILE + std::countr_zero(word));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+    void scan_radar(int row, int col, int direction, std::vector<RadarObj>& results) const;
+    int max_radar_cells() const;
+
+    bool random_free_cell(GameRng& rng, int& row, int& col) const;
+    bool random_roomy_cell(GameRng& rng, int& row, int& col) const;
+
+    // Allocates every tile robots robots moving about can need, so later
+    // writes only recycle tiles
+    void reserve_for_robots(int robots);
+
+    // Tiles currently allocated (for reporting memory use)
+    int allocated_tiles() const;
+
+    void clear();
+};
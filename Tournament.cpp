@@ -0,0 +1,529 @@
+#include "Tournament.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <dlfcn.h>
+#include <link.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// ===== CONSTRUCTOR/DESTRUCTOR =====
+
+Tournament::Tournament(int rows, int cols, TournamentMode mode)
+    : m_rows(rows), m_cols(cols), m_mode(mode), m_isolated(false), m_fork_server(false), m_copies(1), m_tiled(false), m_seed(0),
+      m_next_game(0), m_games_played(0), m_timeouts(0), m_total_rounds(0), m_failed_games(0),
+      m_elapsed_seconds(0.0)
+{
+}
+
+Tournament::~Tournament()
+{
+    unload_libraries();
+}
+
+// ===== LIBRARY LOADING =====
+
+bool Tournament::load_libraries(const std::string& directory, int jobs, BuildProfile profile,
+                                const std::vector<std::string>& names)
+{
+    RobotCompiler compiler(directory);
+    compiler.set_verbose(false);
+    compiler.set_profile(profile);
+    if (jobs > 0) {
+        compiler.set_jobs(jobs);
+    }
+
+    std::vector<std::string> sources = RobotCompiler::find_sources(directory);
+    if (!names.empty()) {
+        // Just the named robots, in the order they are named
+        std::vector<std::string> chosen;
+        for (const auto& name : names) {
+            for (const auto& filename : sources) {
+                if (RobotCompiler::robot_name(filename) == name) {
+                    chosen.push_back(filename);
+                }
+            }
+        }
+        sources = chosen;
+    }
+    std::vector<std::string> built = compiler.build(sources);
+
+    for (const auto& filename : built) {
+        std::string robot_name = RobotCompiler::robot_name(filename);
+        std::string so_path = compiler.library_path(filename);
+
+        void* lib_handle = dlopen(so_path.c_str(), RTLD_NOW);
+        if (!lib_handle) {
+            std::cerr << "dlopen error: " << dlerror() << std::endl;
+            continue;
+        }
+
+        std::string factory_name = "create_" + robot_name;
+        RobotFactory factory = (RobotFactory)dlsym(lib_handle, factory_name.c_str());
+        if (!factory) {
+            std::cerr << "dlsym error: " << dlerror() << std::endl;
+            dlclose(lib_handle);
+            continue;
+        }
+
+        RobotLibrary library;
+        library.name = robot_name;
+        library.so_path = so_path;
+        library.lib_handle = lib_handle;
+        library.factory = factory;
+        m_libraries.push_back(library);
+    }
+
+    m_stats.reset(new RobotStats[m_libraries.size()]);
+    return !m_libraries.empty();
+}
+
+// ===== TOURNAMENT LOOP =====
+
+void Tournament::set_isolated(bool isolated)
+{
+    m_isolated = isolated;
+}
+
+void Tournament::set_fork_server(bool fork_server)
+{
+    m_fork_server = fork_server;
+}
+
+void Tournament::set_copies_per_robot(int copies)
+{
+    m_copies = std::max(copies, 1);
+}
+
+void Tournament::set_tiled(bool tiled)
+{
+    m_tiled = tiled;
+}
+
+void Tournament::set_seed(uint64_t seed)
+{
+    m_seed = seed;
+}
+
+void Tournament::run(int games, int threads, int first_game)
+{
+    if (m_libraries.empty() || games <= 0) {
+        return;
+    }
+    threads = std::max(1, std::min(threads, games));
+    int end_game = first_game + games;
+
+    if (m_fork_server) {
+        auto start = std::chrono::steady_clock::now();
+        run_forked(first_game, end_game, threads);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        m_elapsed_seconds += elapsed.count();
+        return;
+    }
+
+    if (m_isolated) {
+        // One namespace per worker, created up front; glibc caps how many exist
+        int available = m_namespaces.reserve(threads);
+        if (available == 0) {
+            std::cerr << "Could not create a private namespace for robot libraries\n";
+            return;
+        }
+        if (available < threads) {
+            std::cerr << "Only " << available << " private namespaces available, using "
+                      << available << " worker threads\n";
+            threads = available;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Workers pull game numbers from a shared counter until all games are claimed
+    m_next_game = first_game;
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(&Tournament::worker, this, end_game);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    m_elapsed_seconds += elapsed.count();
+}
+
+template <typename ArenaType>
+bool Tournament::play_lineup(int game, const std::vector<int>& lineup, Lmid_t lmid, GameResult& result)
+{
+    // Each game owns its own arena and fresh robot instances. Isolated games
+    // reload the libraries into the worker's namespace so statics start clean.
+    // The random stream depends only on the game number, so a game plays out
+    // the same whichever worker or forked child runs it.
+    ArenaType arena(m_rows, m_cols);
+    arena.set_headless(true);
+    arena.set_seed(m_seed, game);
+    arena.set_link_namespace(lmid);
+    for (int library : lineup) {
+        bool added = m_isolated
+            ? arena.load_robot_library(m_libraries[library].so_path, m_libraries[library].name, library)
+            : arena.add_robot(m_libraries[library].factory, m_libraries[library].name, nullptr, library);
+        if (!added) {
+            // A game short of a robot is not the game the lineup describes
+            std::cerr << "Game " << game << ": could not add " << m_libraries[library].name << "\n";
+            return false;
+        }
+    }
+
+    arena.play_game();
+    result = arena.get_result();
+    if constexpr (ArenaProfile::enabled()) {
+        // Robot i of the game is an instance of library lineup[i]
+        std::lock_guard<std::mutex> lock(m_profile_mutex);
+        m_profile.merge(arena.profile(), lineup);
+    }
+    return true;
+}
+
+// Plays a lineup on the arena type that fits the board: sparse for huge
+// boards, the compile-time sized one for the standard board. False if a
+// robot of the lineup could not be added.
+bool Tournament::play_game(int game, const std::vector<int>& lineup, Lmid_t lmid, GameResult& result)
+{
+    if (m_tiled) {
+        return play_lineup<TiledArena>(game, lineup, lmid, result);
+    }
+    if (m_rows == STANDARD_ROWS && m_cols == STANDARD_COLS) {
+        return play_lineup<StandardArena>(game, lineup, lmid, result);
+    }
+    return play_lineup<Arena>(game, lineup, lmid, result);
+}
+
+void Tournament::worker(int end_game)
+{
+    Lmid_t lmid = LM_ID_BASE;
+    if (m_isolated && !m_namespaces.acquire(lmid)) {
+        return;
+    }
+
+    // Every worker claims one number past the last game before it stops
+    for (long long game = m_next_game++; game < end_game; game = m_next_game++) {
+        GameResult result;
+        if (play_game(game, game_lineup(game), lmid, result)) {
+            record_result(result);
+        } else {
+            m_failed_games++;
+        }
+    }
+
+    if (m_isolated) {
+        m_namespaces.release(lmid);
+    }
+}
+
+// ===== FORK SERVER =====
+
+// Result record a forked game writes back to the server: rounds, winner,
+// timeout, robot count, then (library, is_alive, health) per robot, then in
+// profiling builds the game's profile. A game that could not be set up writes
+// nothing, which the server counts as failed.
+void Tournament::play_forked_game(int game, int fd)
+{
+    // The child's copy of the profile holds the server's totals so far
+    m_profile.clear();
+    GameResult result;
+    if (!play_game(game, game_lineup(game), LM_ID_BASE, result)) {
+        return;
+    }
+
+    std::vector<int> record = { result.rounds, result.winner, result.timeout ? 1 : 0, (int)result.robots.size() };
+    for (const auto& robot : result.robots) {
+        record.push_back(robot.library);
+        record.push_back(robot.is_alive ? 1 : 0);
+        record.push_back(robot.health);
+    }
+    std::vector<char> bytes(reinterpret_cast<const char*>(record.data()),
+                            reinterpret_cast<const char*>(record.data() + record.size()));
+    m_profile.append_to(bytes);
+
+    const char* data = bytes.data();
+    size_t remaining = bytes.size();
+    while (remaining > 0) {
+        ssize_t written = write(fd, data, remaining);
+        if (written <= 0) {
+            break;
+        }
+        data += written;
+        remaining -= written;
+    }
+}
+
+void Tournament::prefault_libraries()
+{
+    // Touch every page of the robot libraries once so each forked child starts
+    // with them mapped, instead of every child taking the same page faults
+    std::vector<void*> handles;
+    for (const auto& library : m_libraries) {
+        handles.push_back(library.lib_handle);
+    }
+
+    dl_iterate_phdr([](struct dl_phdr_info* info, size_t, void* data) -> int {
+        auto* handles = static_cast<std::vector<void*>*>(data);
+        bool is_robot = false;
+        for (void* handle : *handles) {
+            struct link_map* map = nullptr;
+            if (dlinfo(handle, RTLD_DI_LINKMAP, &map) == 0 && map->l_addr == info->dlpi_addr) {
+                is_robot = true;
+                break;
+            }
+        }
+        if (!is_robot) {
+            return 0;
+        }
+
+        long page = sysconf(_SC_PAGESIZE);
+        for (int i = 0; i < info->dlpi_phnum; i++) {
+            const ElfW(Phdr)& segment = info->dlpi_phdr[i];
+            if (segment.p_type != PT_LOAD) {
+                continue;
+            }
+            const volatile char* start = reinterpret_cast<const volatile char*>(info->dlpi_addr + segment.p_vaddr);
+            for (ElfW(Xword) offset = 0; offset < segment.p_memsz; offset += page) {
+                (void)start[offset];
+            }
+        }
+        return 0;
+    }, &handles);
+}
+
+void Tournament::run_forked(int first_game, int end_game, int jobs)
+{
+    struct Child {
+        pid_t pid;
+        int fd;
+        std::vector<char> data;
+    };
+
+    prefault_libraries();
+
+    // Children must not inherit (and later flush) buffered parent output
+    std::cout.flush();
+    std::cerr.flush();
+
+    std::vector<Child> children;
+    int next_game = first_game;
+
+    while (next_game < end_game || !children.empty()) {
+        // Keep up to 'jobs' games in flight
+        while (next_game < end_game && (int)children.size() < jobs) {
+            int fds[2];
+            if (pipe(fds) != 0) {
+                // Without a pipe no game can report back; the games in flight finish
+                std::cerr << "pipe: " << std::strerror(errno) << ", " << end_game - next_game
+                          << " games not played\n";
+                m_failed_games += end_game - next_game;
+                next_game = end_game;
+                break;
+            }
+
+            pid_t pid = fork();
+            int fork_error = errno;
+            if (pid == 0) {
+                close(fds[0]);
+                play_forked_game(next_game, fds[1]);
+                close(fds[1]);
+                // Closing the libraries runs their destructors, which is where
+                // instrumented (pgo-generate) robots write out their profiles
+                unload_libraries();
+                _exit(0);
+            }
+
+            close(fds[1]);
+            if (pid < 0) {
+                std::cerr << "fork: " << std::strerror(fork_error) << ", game " << next_game << " not played\n";
+                close(fds[0]);
+                m_failed_games++;
+            } else {
+                children.push_back(Child{ pid, fds[0], {} });
+            }
+            next_game++;
+        }
+
+        if (children.empty()) {
+            break;
+        }
+
+        std::vector<pollfd> fds;
+        for (const auto& child : children) {
+            fds.push_back(pollfd{ child.fd, POLLIN, 0 });
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            continue;
+        }
+
+        // Read whatever is ready; a child is finished when its pipe reaches EOF
+        for (size_t i = fds.size(); i-- > 0;) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            Child& child = children[i];
+            char buffer[4096];
+            ssize_t count = read(child.fd, buffer, sizeof(buffer));
+            if (count > 0) {
+                child.data.insert(child.data.end(), buffer, buffer + count);
+                continue;
+            }
+
+            close(child.fd);
+            int status = 0;
+            waitpid(child.pid, &status, 0);
+
+            // The result ints, then whatever profile follows them
+            int header[4] = {};
+            size_t record_size = 0;
+            if (child.data.size() >= sizeof(header)) {
+                std::memcpy(header, child.data.data(), sizeof(header));
+                record_size = (4 + 3 * (size_t)std::max(header[3], 0)) * sizeof(int);
+            }
+            std::vector<int> record(std::min(record_size, child.data.size()) / sizeof(int));
+            std::memcpy(record.data(), child.data.data(), record.size() * sizeof(int));
+
+            if (record_size > 0 && record.size() * sizeof(int) == record_size &&
+                m_profile.merge_bytes(child.data.data() + record_size, child.data.size() - record_size)) {
+                GameResult result;
+                result.rounds = record[0];
+                result.winner = record[1];
+                result.timeout = record[2] != 0;
+                for (int r = 0; r < record[3]; r++) {
+                    RobotResult robot;
+                    robot.library = record[4 + 3 * r];
+                    robot.is_alive = record[5 + 3 * r] != 0;
+                    robot.health = record[6 + 3 * r];
+                    result.robots.push_back(robot);
+                }
+                record_result(result);
+            } else {
+                m_failed_games++;
+            }
+
+            children.erase(children.begin() + i);
+        }
+    }
+}
+
+std::vector<int> Tournament::game_lineup(int game) const
+{
+    int count = m_libraries.size();
+    std::vector<int> lineup;
+
+    // Each library in the game plays m_copies instances; results are credited
+    // by each robot's library id, so every copy counts towards its library's stats
+    if (m_mode == TournamentMode::round_robin && count > 2) {
+        // Walk the pairs (i, j), i < j, and pick the one this game falls on
+        int pair = game % (count * (count - 1) / 2);
+        for (int i = 0; i < count; i++) {
+            for (int j = i + 1; j < count; j++) {
+                if (pair-- == 0) {
+                    for (int copy = 0; copy < m_copies; copy++) {
+                        lineup.push_back(i);
+                        lineup.push_back(j);
+                    }
+                    return lineup;
+                }
+            }
+        }
+    }
+
+    for (int copy = 0; copy < m_copies; copy++) {
+        for (int i = 0; i < count; i++) {
+            lineup.push_back(i);
+        }
+    }
+    return lineup;
+}
+
+void Tournament::record_result(const GameResult& result)
+{
+    m_games_played.fetch_add(1, std::memory_order_relaxed);
+    m_total_rounds.fetch_add(result.rounds, std::memory_order_relaxed);
+    if (result.timeout) {
+        m_timeouts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < result.robots.size(); i++) {
+        int library = result.robots[i].library;
+        if (library < 0 || library >= (int)m_libraries.size()) {
+            continue;
+        }
+        RobotStats& stats = m_stats[library];
+        stats.games.fetch_add(1, std::memory_order_relaxed);
+        stats.damage_taken.fetch_add(100 - result.robots[i].health, std::memory_order_relaxed);
+        if (result.robots[i].is_alive) {
+            stats.survivals.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (result.winner == (int)i) {
+            stats.wins.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+// ===== DISPLAY =====
+
+void Tournament::print_summary() const
+{
+    long games = m_games_played.load();
+
+    std::cout << "========================================\n";
+    std::cout << "Tournament: " << games << " games, " << m_timeouts.load() << " timeouts";
+    if (m_failed_games.load() > 0) {
+        std::cout << ", " << m_failed_games.load() << " failed";
+    }
+    if (games > 0) {
+        std::cout << ", " << std::fixed << std::setprecision(1)
+                  << (double)m_total_rounds.load() / games << " rounds/game";
+    }
+    if (m_elapsed_seconds > 0.0) {
+        std::cout << ", " << std::fixed << std::setprecision(1)
+                  << games / m_elapsed_seconds << " games/sec";
+    }
+    std::cout << "\n\n";
+
+    std::cout << std::left << std::setw(14) << "Robot" << std::right
+              << std::setw(8) << "Games" << std::setw(8) << "Wins"
+              << std::setw(11) << "Survivals" << std::setw(12) << "Avg damage" << "\n";
+    for (size_t i = 0; i < m_libraries.size(); i++) {
+        const RobotStats& stats = m_stats[i];
+        long played = stats.games.load();
+        std::cout << std::left << std::setw(14) << m_libraries[i].name << std::right
+                  << std::setw(8) << played << std::setw(8) << stats.wins.load()
+                  << std::setw(11) << stats.survivals.load() << std::setw(12) << std::fixed
+                  << std::setprecision(1) << (played ? (double)stats.damage_taken.load() / played : 0.0)
+                  << "\n";
+    }
+    std::cout << "========================================\n";
+
+    // Profiling builds only; stderr keeps the summary intact
+    if constexpr (ArenaProfile::enabled()) {
+        std::vector<std::string> names;
+        for (const auto& library : m_libraries) {
+            names.push_back(library.name);
+        }
+        m_profile.print(std::cerr, names);
+    }
+}
+
+// ===== CLEANUP =====
+
+void Tournament::unload_libraries()
+{
+    for (auto& library : m_libraries) {
+        if (library.lib_handle) {
+            dlclose(library.lib_handle);
+            library.lib_handle = nullptr;
+        }
+    }
+    m_libraries.clear();
+}
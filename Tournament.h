@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include "Arena.h"
+#include "NamespacePool.h"
+
+// A robot shared object loaded once and shared by every game of a tournament
+struct RobotLibrary {
+    std::string name;
+    std::string so_path;
+    void* lib_handle;
+    RobotFactory factory;
+
+    RobotLibrary() : lib_handle(nullptr), factory(nullptr) {}
+};
+
+// Per-robot totals, updated lock-free by the worker threads
+struct RobotStats {
+    std::atomic<long> games{0};
+    std::atomic<long> wins{0};
+    std::atomic<long> survivals{0};
+    std::atomic<long> damage_taken{0};
+};
+
+enum class TournamentMode {
+    free_for_all,   // every robot plays in every game
+    round_robin     // game i plays the (i % pairs)-th pairing of two robots
+};
+
+class Tournament {
+private:
+    int m_rows;
+    int m_cols;
+    TournamentMode m_mode;
+    bool m_isolated;   // Load each worker's robots into its own dlmopen namespace
+    bool m_fork_server;  // Fork one copy-on-write child per game instead of using threads
+    int m_copies;        // Instances of each robot in a game
+    bool m_tiled;        // Play on TiledArena (sparse board) instead of Arena
+    uint64_t m_seed;     // Game g plays the arena random stream (m_seed, g)
+    NamespacePool m_namespaces;
+
+    std::vector<RobotLibrary> m_libraries;
+    std::unique_ptr<RobotStats[]> m_stats;
+
+    std::atomic<long long> m_next_game;  // wider than a game number, so claims past the last game cannot overflow
+    std::atomic<long> m_games_played;
+    std::atomic<long> m_timeouts;
+    std::atomic<long> m_total_rounds;
+    std::atomic<long> m_failed_games;
+    double m_elapsed_seconds;
+    ArenaProfile m_profile;     // every game's, per library (ARENA_PROFILE builds)
+    std::mutex m_profile_mutex;
+
+    std::vector<int> game_lineup(int game) const;
+    template <typename ArenaType>
+    bool play_lineup(int game, const std::vector<int>& lineup, Lmid_t lmid, GameResult& result);
+    bool play_game(int game, const std::vector<int>& lineup, Lmid_t lmid, GameResult& result);
+    void worker(int end_game);
+    void run_forked(int first_game, int end_game, int jobs);
+    void play_forked_game(int game, int fd);
+    void prefault_libraries();
+    void record_result(const GameResult& result);
+
+public:
+    Tournament(int rows = 20, int cols = 20, TournamentMode mode = TournamentMode::free_for_all);
+    ~Tournament();
+
+    // Every Robot_*.cpp in directory, or only the named robots (in that order)
+    bool load_libraries(const std::string& directory = ".", int jobs = 0,
+                        BuildProfile profile = BuildProfile::release,
+                        const std::vector<std::string>& names = {});
+    void set_isolated(bool isolated);
+    void set_fork_server(bool fork_server);
+    void set_copies_per_robot(int copies);
+    void set_tiled(bool tiled);
+    void set_seed(uint64_t seed);
+    // Plays games first_game .. first_game + games - 1
+    void run(int games, int threads, int first_game = 0);
+    void print_summary() const;
+
+    const std::vector<RobotLibrary>& libraries() const { return m_libraries; }
+    long games_played() const { return m_games_played.load(); }
+    long total_rounds() const { return m_total_rounds.load(); }
+    double elapsed_seconds() const { return m_elapsed_seconds; }
+
+    void unload_libraries();
+};
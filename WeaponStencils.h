@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include "RobotBase.h"
+#include "RadarTable.h"
+
+// Compile-time hit tables for the weapons.
+//
+// A shot is aimed at any cell; the flamethrower and hammer only care which of
+// the eight directions that cell lies in, the railgun follows the exact line
+// (ShotLine) and the grenade lands on the cell itself. Each area weapon is a
+// Stencil of (row, col) offsets plus their bounding rectangle, so resolving a
+// shot is one rectangle test and a sweep over a handful of offsets.
+
+// Direction index 1-8 of a (dr, dc) step with components in -1..1; 0 for (0, 0)
+constexpr std::array<std::array<int, 3>, 3> DIRECTION_OF = [] {
+    std::array<std::array<int, 3>, 3> table{};
+    for (int d = 1; d <= 8; d++) {
+        table[directions[d].first + 1][directions[d].second + 1] = d;
+    }
+    return table;
+}();
+
+// Direction from (row, col) toward a target cell anywhere on the board; 0 if
+// the target is the cell itself
+constexpr int direction_toward(int row, int col, int target_row, int target_col)
+{
+    int dr = (target_row > row) - (target_row < row);
+    int dc = (target_col > col) - (target_col < col);
+    return DIRECTION_OF[dr + 1][dc + 1];
+}
+
+struct Stencil {
+    static constexpr int MAX_CELLS = 12;
+
+    int count = 0;
+    std::pair<int, int> cells[MAX_CELLS] = {};
+    int r0 = 0, c0 = 0, r1 = 0, c1 = 0;     // bounding rectangle of the cells
+
+    constexpr void add(int dr, int dc)
+    {
+        if (count == 0) {
+            r0 = r1 = dr;
+            c0 = c1 = dc;
+        }
+        r0 = dr < r0 ? dr : r0;
+        r1 = dr > r1 ? dr : r1;
+        c0 = dc < c0 ? dc : c0;
+        c1 = dc > c1 ? dc : c1;
+        cells[count++] = { dr, dc };
+    }
+};
+
+// Flamethrower: 3 cells wide, 4 long, starting next to the shooter. The same
+// band as the first 4 steps of a radar ray, so diagonal flames have no gaps.
+// Direction 0 (shooting at yourself) burns nothing.
+constexpr std::array<Stencil, 9> FLAMETHROWER_STENCILS = [] {
+    std::array<Stencil, 9> stencils{};
+    for (int d = 1; d <= 8; d++) {
+        for (int k = 0; k < 3 * 4; k++) {
+            int dr = 0, dc = 0;
+            RadarTable::cell(d, k, dr, dc);
+            stencils[d].add(dr, dc);
+        }
+    }
+    return stencils;
+}();
+
+// Hammer: the one adjacent cell in the direction of the shot
+constexpr std::array<Stencil, 9> HAMMER_STENCILS = [] {
+    std::array<Stencil, 9> stencils{};
+    for (int d = 1; d <= 8; d++) {
+        stencils[d].add(directions[d].first, directions[d].second);
+    }
+    return stencils;
+}();
+
+// Grenade: the 3x3 block around the target cell
+constexpr Stencil GRENADE_STENCIL = [] {
+    Stencil stencil;
+    for (int dr = -1; dr <= 1; dr++) {
+        for (int dc = -1; dc <= 1; dc++) {
+            stencil.add(dr, dc);
+        }
+    }
+    return stencil;
+}();
+
+// The railgun's path from a shooter through its target cell and on past it:
+// one step along the longer axis per cell, the shorter axis rounded to the
+// nearest cell (halves away from the shooter). From (2,2) toward (4,5) that
+// is (3,3), (3,4), (4,5), (5,6), (5,7), (6,8), ...
+//
+// Rasterized incrementally with an error term, one add and compare per cell,
+// so nothing needs to be tabulated per slope.
+class ShotLine {
+private:
+    int m_row, m_col;
+    int m_major_dr, m_major_dc;     // unit step along the longer axis
+    int m_minor_dr, m_minor_dc;     // unit step along the shorter axis
+    int m_major, m_minor;           // |delta| along each axis
+    int m_error;                    // 2 * k * minor + major, less what has been stepped
+
+public:
+    constexpr ShotLine(int row, int col, int target_row, int target_col)
+        : m_row(row), m_col(col), m_major_dr(0), m_major_dc(0), m_minor_dr(0), m_minor_dc(0)
+    {
+        int dr = target_row - row;
+        int dc = target_col - col;
+        int sr = (dr > 0) - (dr < 0);
+        int sc = (dc > 0) - (dc < 0);
+        if ((dr < 0 ? -dr : dr) > (dc < 0 ? -dc : dc)) {
+            m_major_dr = sr;
+            m_minor_dc = sc;
+            m_major = dr < 0 ? -dr : dr;
+            m_minor = dc < 0 ? -dc : dc;
+        } else {
+            m_major_dc = sc;
+            m_minor_dr = sr;
+            m_major = dc < 0 ? -dc : dc;
+            m_minor = dr < 0 ? -dr : dr;
+        }
+        m_error = m_major;
+    }
+
+    // False when aimed at the shooter's own cell
+    constexpr bool valid() const { return m_major > 0; }
+
+    // Straight or diagonal: the path is one of the eight directions
+    constexpr bool is_direction() const { return m_minor == 0 || m_minor == m_major; }
+
+    // Steps to the next cell of the path
+    constexpr void next(int& row, int& col)
+    {
+        m_row += m_major_dr;
+        m_col += m_major_dc;
+        m_error += 2 * m_minor;
+        if (m_error >= 2 * m_major) {
+            m_error -= 2 * m_major;
+            m_row += m_minor_dr;
+            m_col += m_minor_dc;
+        }
+        row = m_row;
+        col = m_col;
+    }
+};
@@ -0,0 +1,266 @@
+#include "Arena.h"
+#include "AllocCounter.h"
+#include "ParseArgs.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+
+// Microbenchmarks for the arena's hot primitives (make bench).
+//
+// Every primitive is driven on canned board layouts at several sizes, on the
+// same arena types the game runners use. Ops run in short batches on a fresh
+// arena each: setting the arena up and a few warm-up ops are not timed. Ops
+// only pick live robots, and a batch ends early once the game on its arena is
+// over, so shots and damage always land on a board that still has live robots.
+// Each op includes drawing its own random arguments from a GameRng.
+//
+// Built with COUNT_ALLOCS, so allocations per op are the arena's own (the
+// bench robots never run any code during an op).
+
+static const int BATCH_OPS = 64;        // ops per fresh arena
+static const int WARMUP_OPS = 8;        // untimed ops per arena
+static const uint64_t BENCH_SEED = 1;
+
+// ===== BENCH ROBOT =====
+
+// A robot that is only ever moved, shot and damaged by the arena
+class BenchRobot : public RobotBase {
+public:
+    BenchRobot() : RobotBase(3, 4, railgun) {}
+
+    void get_radar_direction(int& radar_direction) override { radar_direction = 0; }
+    void process_radar_results(const std::vector<RadarObj>&) override {}
+    bool get_shot_location(int&, int&) override { return false; }
+    void get_move_direction(int& direction, int& distance) override { direction = 0; distance = 0; }
+};
+
+// The robots of the current arena, in arena index order (the arena owns them)
+static std::vector<RobotBase*> g_robots;
+
+// The robot create_bench_robot made last; it joins g_robots only once
+// add_robot has accepted it, as a rejected one is deleted again
+static RobotBase* g_created = nullptr;
+
+static RobotBase* create_bench_robot()
+{
+    g_created = new BenchRobot();
+    return g_created;
+}
+
+// ===== LAYOUTS =====
+
+// Obstacles are mounds only, so moving never lands a robot in a pit or on a
+// flamethrower and a move benchmark measures moves
+enum class Layout { empty, sparse, dense, maze };
+
+static const Layout LAYOUTS[] = { Layout::empty, Layout::sparse, Layout::dense, Layout::maze };
+
+static const char* layout_name(Layout layout)
+{
+    switch (layout) {
+        case Layout::empty:  return "empty";
+        case Layout::sparse: return "sparse";
+        case Layout::dense:  return "dense";
+        case Layout::maze:   return "maze";
+    }
+    return "?";
+}
+
+template <typename ArenaType>
+static void build_layout(ArenaType& arena, Layout layout, int rows, int cols, GameRng& rng)
+{
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            bool mound = false;
+            switch (layout) {
+                case Layout::empty:
+                    break;
+                case Layout::sparse:
+                    mound = rng.below(100) < 5;
+                    break;
+                case Layout::dense:
+                    mound = rng.below(100) < 30;
+                    break;
+                case Layout::maze:
+                    // Walls along every fourth row and column, with a gap in one cell of four
+                    mound = (r % 4 == 3 || c % 4 == 3) && rng.below(4) != 0;
+                    break;
+            }
+            if (mound) {
+                arena.place_obstacle(r, c, MOUND);
+            }
+        }
+    }
+}
+
+// ===== HARNESS =====
+
+struct Sample {
+    double ns_per_op;
+    double allocs_per_op;
+};
+
+// Times op(arena, rng) over ops calls, BATCH_OPS at a time on a fresh arena
+template <typename ArenaType, typename Op>
+static Sample measure(int rows, int cols, Layout layout, int ops, Op op)
+{
+    using Clock = std::chrono::steady_clock;
+    int robots = std::max(4, rows * cols / 50);
+    long long ns = 0;
+    long long allocs = 0;
+
+    int done = 0;
+    for (int batch = 0; done < ops; batch++) {
+        g_robots.clear();
+        ArenaType arena(rows, cols);
+        arena.set_headless(true);
+        arena.set_seed(BENCH_SEED, batch);
+        GameRng rng(BENCH_SEED + 1, batch);
+        build_layout(arena, layout, rows, cols, rng);
+        for (int i = 0; i < robots && arena.add_robot(create_bench_robot, "bench"); i++) {
+            g_robots.push_back(g_created);
+        }
+        arena.reserve_turn_buffers();
+        for (int i = 0; i < WARMUP_OPS && !arena.is_game_over(); i++) {
+            op(arena, rng);
+        }
+
+        int count = std::min(BATCH_OPS, ops - done);
+        int i = 0;
+        long long allocs_before = AllocCounter::count();
+        auto start = Clock::now();
+        for (; i < count && !arena.is_game_over(); i++) {
+            op(arena, rng);
+        }
+        auto end = Clock::now();
+        allocs += AllocCounter::count() - allocs_before;
+        ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        done += i;
+    }
+    return { (double)ns / ops, (double)allocs / ops };
+}
+
+// A random live robot's index and location; measure only runs ops while at
+// least two robots are alive, so the draw always ends
+static int random_robot(GameRng& rng, int& row, int& col)
+{
+    int index = rng.below(g_robots.size());
+    while (g_robots[index]->get_health() <= 0) {
+        index = rng.below(g_robots.size());
+    }
+    g_robots[index]->get_current_location(row, col);
+    return index;
+}
+
+// ===== PRIMITIVES =====
+
+// Runs every primitive whose name contains filter on one arena type and size
+template <typename ArenaType>
+static void run_primitives(const char* arena_name, int rows, int cols, int ops, const std::string& filter)
+{
+    std::vector<RadarObj> radar_results;
+    radar_results.reserve(3 * (std::max(rows, cols) + 1));
+
+    auto report = [&](const char* primitive, auto op) {
+        if (std::string(primitive).find(filter) == std::string::npos) {
+            return;
+        }
+        for (Layout layout : LAYOUTS) {
+            Sample sample = measure<ArenaType>(rows, cols, layout, ops, op);
+            std::printf("%-24s %-14s %4dx%-5d %-7s %10.1f %10.3f\n", primitive, arena_name, rows, cols,
+                        layout_name(layout), sample.ns_per_op, sample.allocs_per_op);
+        }
+    };
+
+    report("get_robot_at", [&](ArenaType& arena, GameRng& rng) {
+        arena.get_robot_at(rng.below(rows), rng.below(cols));
+    });
+    report("scan_radar", [&](ArenaType& arena, GameRng& rng) {
+        int row, col;
+        random_robot(rng, row, col);
+        radar_results.clear();
+        arena.scan_radar(row, col, rng.below(9), radar_results);
+    });
+    report("move_robot", [&](ArenaType& arena, GameRng& rng) {
+        int row, col;
+        int robot = random_robot(rng, row, col);
+        auto [dr, dc] = directions[rng.uniform(1, 8)];
+        arena.template move_robot<false>(robot, row + dr, col + dc);
+    });
+    report("try_multiple_directions", [&](ArenaType& arena, GameRng& rng) {
+        int row, col;
+        int robot = random_robot(rng, row, col);
+        arena.template try_multiple_directions<false>(robot, rng.uniform(1, 8), rng.uniform(1, 3));
+    });
+
+    // Shots resolve their damage as a turn would; damage_events alone is
+    // queue_damage plus resolve_damage
+    report("shoot_flamethrower", [&](ArenaType& arena, GameRng& rng) {
+        int row, col;
+        random_robot(rng, row, col);
+        arena.shoot_flamethrower(row, col, rng.uniform(1, 8));
+        arena.template resolve_damage<false>();
+    });
+    report("shoot_railgun", [&](ArenaType& arena, GameRng& rng) {
+        int row, col, target_row, target_col;
+        random_robot(rng, row, col);
+        random_robot(rng, target_row, target_col);
+        arena.shoot_railgun(row, col, target_row, target_col);
+        arena.template resolve_damage<false>();
+    });
+    report("shoot_grenade", [&](ArenaType& arena, GameRng& rng) {
+        int row, col;
+        random_robot(rng, row, col);
+        arena.shoot_grenade(row + rng.uniform(-1, 1), col + rng.uniform(-1, 1));
+        arena.template resolve_damage<false>();
+    });
+    report("shoot_hammer", [&](ArenaType& arena, GameRng& rng) {
+        int row, col;
+        random_robot(rng, row, col);
+        arena.shoot_hammer(row, col, rng.uniform(1, 8));
+        arena.template resolve_damage<false>();
+    });
+    report("damage_events", [&](ArenaType& arena, GameRng& rng) {
+        int row, col;
+        arena.queue_damage(random_robot(rng, row, col), rng.uniform(5, 25));
+        arena.template resolve_damage<false>();
+    });
+}
+
+static void print_usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--ops N] [--filter NAME]\n"
+              << "  --ops N        timed ops per primitive, layout and size (default: 20000)\n"
+              << "  --filter NAME  only primitives whose name contains NAME\n";
+}
+
+int main(int argc, char* argv[])
+{
+    int ops = 20000;
+    std::string filter;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--ops" && i + 1 < argc && parse_int(argv[i + 1], 1, ops)) {
+            i++;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::printf("%-24s %-14s %-10s %-7s %10s %10s\n", "primitive", "arena", "size", "layout", "ns/op", "allocs/op");
+
+    // The standard board on both the compile-time sized and the generic storage,
+    // then larger boards on the generic one
+    run_primitives<StandardArena>("StandardArena", STANDARD_ROWS, STANDARD_COLS, ops, filter);
+    run_primitives<Arena>("Arena", STANDARD_ROWS, STANDARD_COLS, ops, filter);
+    run_primitives<Arena>("Arena", 64, 64, ops, filter);
+    run_primitives<Arena>("Arena", 256, 256, ops, filter);
+    return 0;
+}
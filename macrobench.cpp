@@ -0,0 +1,271 @@
+#include "Arena.h"
+#include "Tournament.h"
+#include "ParseArgs.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <climits>
+
+// End-to-end benchmark (make macrobench): complete headless games of the
+// bundled robots from a fixed scenario corpus, written out as JSON so runs of
+// different builds can be compared.
+//
+// Each scenario plays games 0..n-1 with the arena random stream (seed, game),
+// so obstacles, placements and teleports are the same in every run; the
+// robots' own randomness (Flame_e_o and Garrett seed from the clock) is not.
+// Rounds are timed one by one for the latency percentiles. The scaling
+// curves repeat one scenario over board sizes and robot counts, and run a
+// Tournament over 1, 2, 4, ... worker threads.
+
+// The bundled robots, in lineup order (the order a tournament loads them in):
+// two robots are Flame_e_o and Garrett, more repeat the list
+static const char* const CORPUS_ROBOTS[] = { "Flame_e_o", "Garrett", "Ratboy" };
+
+// Obstacle cover of the dense corpus scenarios, as a fraction of the field
+static const double DENSE_OBSTACLES = 0.4;
+
+struct Scenario {
+    std::string name;
+    int rows;
+    int cols;
+    int robots;
+    double obstacle_density;    // fraction of the field covered by obstacles; 0 is open, negative the standard counts
+};
+
+struct ScenarioResult {
+    Scenario scenario;
+    int games;
+    long rounds;
+    double seconds;             // time spent in rounds, set-up excluded
+    double p50_us;              // round latency percentiles
+    double p99_us;
+};
+
+// Games for a board: base_games on the standard board, fewer on bigger ones
+static int games_for(int base_games, int rows, int cols)
+{
+    long long scaled = (long long)base_games * STANDARD_ROWS * STANDARD_COLS / ((long long)rows * cols);
+    return (int)std::max(scaled, 4LL);
+}
+
+// Value at fraction p of the sorted samples
+static double percentile(std::vector<double>& samples, double p)
+{
+    if (samples.empty()) {
+        return 0.0;
+    }
+    size_t k = std::min(samples.size() - 1, (size_t)(p * samples.size()));
+    std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+    return samples[k];
+}
+
+// ===== SCENARIOS =====
+
+template <typename ArenaType>
+static ScenarioResult play_scenario(const Scenario& scenario, const std::vector<const RobotLibrary*>& lineup,
+                                    int games, uint64_t seed)
+{
+    using Clock = std::chrono::steady_clock;
+    ScenarioResult result{ scenario, games, 0, 0.0, 0.0, 0.0 };
+    std::vector<double> latencies;
+
+    for (int game = 0; game < games; game++) {
+        ArenaType arena(scenario.rows, scenario.cols);
+        arena.set_headless(true);
+        arena.set_seed(seed, game);
+        if (scenario.obstacle_density >= 0.0) {
+            arena.set_obstacle_density(scenario.obstacle_density);
+        }
+        for (int i = 0; i < scenario.robots; i++) {
+            const RobotLibrary* library = lineup[i % lineup.size()];
+            arena.add_robot(library->factory, library->name);
+        }
+        arena.start_game();
+
+        while (!arena.is_game_over()) {
+            auto start = Clock::now();
+            arena.play_round();
+            std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+            latencies.push_back(elapsed.count());
+            result.seconds += elapsed.count() / 1e6;
+        }
+        result.rounds += arena.get_result().rounds;
+    }
+
+    result.p50_us = percentile(latencies, 0.50);
+    result.p99_us = percentile(latencies, 0.99);
+    return result;
+}
+
+static ScenarioResult run_scenario(const Scenario& scenario, const std::vector<const RobotLibrary*>& lineup,
+                                   int games, uint64_t seed)
+{
+    std::cerr << "  " << scenario.name << " (" << games << " games)\n";
+    if (scenario.rows == STANDARD_ROWS && scenario.cols == STANDARD_COLS) {
+        return play_scenario<StandardArena>(scenario, lineup, games, seed);
+    }
+    return play_scenario<Arena>(scenario, lineup, games, seed);
+}
+
+// ===== JSON =====
+
+static std::string json_scenario(const ScenarioResult& result)
+{
+    std::ostringstream out;
+    double seconds = std::max(result.seconds, 1e-9);
+    out << "{\"name\": \"" << result.scenario.name << "\""
+        << ", \"rows\": " << result.scenario.rows
+        << ", \"cols\": " << result.scenario.cols
+        << ", \"robots\": " << result.scenario.robots
+        << ", \"obstacle_density\": " << result.scenario.obstacle_density
+        << ", \"games\": " << result.games
+        << ", \"rounds\": " << result.rounds
+        << ", \"seconds\": " << result.seconds
+        << ", \"games_per_sec\": " << result.games / seconds
+        << ", \"rounds_per_sec\": " << result.rounds / seconds
+        << ", \"round_latency_us\": {\"p50\": " << result.p50_us << ", \"p99\": " << result.p99_us << "}}";
+    return out.str();
+}
+
+static std::string json_list(const std::vector<std::string>& items, const std::string& indent)
+{
+    std::string out = "[\n";
+    for (size_t i = 0; i < items.size(); i++) {
+        out += indent + "  " + items[i] + (i + 1 < items.size() ? ",\n" : "\n");
+    }
+    return out + indent + "]";
+}
+
+static void print_usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--games N] [--seed N] [--max-threads N] [--out FILE]\n"
+              << "  --games N        games per scenario on a 20x20 board, fewer on bigger boards (default: 200)\n"
+              << "  --seed N         arena random stream seed (default: 1)\n"
+              << "  --max-threads N  largest thread count in the thread scaling curve (default: all cores)\n"
+              << "  --out FILE       write the JSON report to FILE instead of stdout\n";
+}
+
+int main(int argc, char* argv[])
+{
+    int base_games = 200;
+    uint64_t seed = 1;
+    int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string out_path;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--games" && i + 1 < argc && parse_int(argv[i + 1], 1, base_games)) {
+            i++;
+        } else if (arg == "--seed" && i + 1 < argc && parse_seed(argv[i + 1], seed)) {
+            i++;
+        } else if (arg == "--max-threads" && i + 1 < argc && parse_int(argv[i + 1], 1, max_threads)) {
+            i++;
+        } else if (arg == "--out" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // The corpus robots are compiled (or taken from the cache) and loaded once;
+    // other Robot_*.cpp files in the directory take no part
+    std::vector<std::string> corpus_names(std::begin(CORPUS_ROBOTS), std::end(CORPUS_ROBOTS));
+    Tournament libraries;
+    libraries.load_libraries(".", 0, BuildProfile::release, corpus_names);
+    std::vector<const RobotLibrary*> lineup;
+    for (const auto& library : libraries.libraries()) {
+        lineup.push_back(&library);
+    }
+    if (lineup.size() != corpus_names.size()) {
+        std::cerr << "The corpus needs Robot_Flame_e_o, Robot_Garrett and Robot_Ratboy\n";
+        return 1;
+    }
+
+    // The corpus: open fields and fields 40% covered by obstacles, 2 and 11
+    // robots, 20x20 and 500x500
+    std::cerr << "Corpus\n";
+    std::vector<std::string> corpus;
+    for (int size : { 20, 500 }) {
+        for (double density : { 0.0, DENSE_OBSTACLES }) {
+            for (int robots : { 2, 11 }) {
+                std::string name = (density == 0.0 ? "open_" : "dense_") + std::to_string(size) + "x" +
+                                   std::to_string(size) + "_" + std::to_string(robots) + "robots";
+                Scenario scenario{ name, size, size, robots, density };
+                corpus.push_back(json_scenario(run_scenario(scenario, lineup, games_for(base_games, size, size), seed)));
+            }
+        }
+    }
+
+    // Scaling curves around the standard game: three robots, the standard obstacle counts
+    std::cerr << "Board size scaling\n";
+    std::vector<std::string> by_size;
+    for (int size : { 20, 50, 100, 200, 500 }) {
+        Scenario scenario{ "size_" + std::to_string(size), size, size, 3, -1.0 };
+        by_size.push_back(json_scenario(run_scenario(scenario, lineup, games_for(base_games, size, size), seed)));
+    }
+
+    std::cerr << "Robot count scaling\n";
+    std::vector<std::string> by_robots;
+    for (int robots : { 2, 3, 5, 8, 11, 16 }) {
+        Scenario scenario{ "robots_" + std::to_string(robots), STANDARD_ROWS, STANDARD_COLS, robots, -1.0 };
+        by_robots.push_back(json_scenario(run_scenario(scenario, lineup, base_games, seed)));
+    }
+
+    // Threads: a free-for-all tournament of the corpus robots per thread count
+    std::cerr << "Thread scaling\n";
+    std::vector<std::string> by_threads;
+    std::vector<int> thread_counts;
+    for (long long threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back((int)threads);
+    }
+    thread_counts.push_back(max_threads);
+    for (int threads : thread_counts) {
+        Tournament tournament;
+        tournament.set_seed(seed);
+        if (!tournament.load_libraries(".", 0, BuildProfile::release, corpus_names)) {
+            return 1;
+        }
+        // Four games per thread at base_games, capped at what a tournament can number
+        int games = (int)std::min((long long)base_games * 4 * threads, (long long)INT_MAX);
+        std::cerr << "  " << threads << " threads (" << games << " games)\n";
+        tournament.run(games, threads);
+        double seconds = std::max(tournament.elapsed_seconds(), 1e-9);
+        std::ostringstream entry;
+        entry << "{\"threads\": " << threads
+              << ", \"games\": " << tournament.games_played()
+              << ", \"seconds\": " << tournament.elapsed_seconds()
+              << ", \"games_per_sec\": " << tournament.games_played() / seconds
+              << ", \"rounds_per_sec\": " << tournament.total_rounds() / seconds << "}";
+        by_threads.push_back(entry.str());
+    }
+
+    std::ostringstream report;
+    report << "{\n"
+           << "  \"seed\": " << seed << ",\n"
+           << "  \"base_games\": " << base_games << ",\n"
+           << "  \"corpus\": " << json_list(corpus, "  ") << ",\n"
+           << "  \"scaling\": {\n"
+           << "    \"board_size\": " << json_list(by_size, "    ") << ",\n"
+           << "    \"robot_count\": " << json_list(by_robots, "    ") << ",\n"
+           << "    \"threads\": " << json_list(by_threads, "    ") << "\n"
+           << "  }\n"
+           << "}\n";
+
+    if (out_path.empty()) {
+        std::cout << report.str();
+        return 0;
+    }
+    std::ofstream out(out_path);
+    if (!out) {
+        std::cerr << "Could not write " << out_path << "\n";
+        return 1;
+    }
+    out << report.str();
+    return 0;
+}
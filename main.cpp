@@ -1,19 +1,208 @@
 #include "Arena.h"
+#include "Tournament.h"
+#include "NamespacePool.h"
+#include "AllocCounter.h"
+#include "ParseArgs.h"
 #include <iostream>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+#include <random>
 
-int main() 
+// Arenas with more cells than this use the tiled (sparse) board
+static const long long TILED_BOARD_CELLS = 2048LL * 2048;
+
+// Plays games first_game, first_game + 1, ... one after another on a fresh
+// ArenaType each time. Profiling builds print one profile for the whole run.
+template <typename ArenaType>
+static int play_games(int games, int first_game, uint64_t seed, int rows, int cols, bool headless,
+                      Lmid_t lmid, int copies, int jobs, BuildProfile profile)
 {
-    // Create a 20x20 arena
-    Arena arena(20, 20);
-    
-    // Load all robots from current directory
-    if (!arena.load_robots(".")) {
-        std::cerr << "Failed to load any robots!\n";
+    long long steady_allocs = 0;
+    ArenaProfile run_profile;
+    std::vector<std::string> robot_names;
+    for (int game = first_game; game < first_game + games; game++) {
+        // Create the arena (20x20 unless --size says otherwise)
+        ArenaType arena(rows, cols);
+        arena.set_headless(headless);
+        arena.set_seed(seed, game);
+        arena.set_link_namespace(lmid);
+        arena.set_copies_per_robot(copies);
+
+        // Load all robots from current directory (compiled once, then served from the cache)
+        if (!arena.load_robots(".", jobs, profile)) {
+            std::cerr << "Failed to load any robots!\n";
+            return 1;
+        }
+
+        // Run the game
+        arena.run_game();
+        run_profile.merge(arena.profile());
+        if (ArenaProfile::enabled() && robot_names.empty()) {
+            robot_names = arena.robot_names();
+        }
+        
+        if (AllocCounter::enabled()) {
+            // Turn loop allocation check: the arena should stop allocating after round 1
+            long long allocs = arena.steady_state_allocations();
+            int rounds = std::max(arena.get_result().rounds - 1, 1);
+            std::cout << "allocs after round 1: " << allocs << " ("
+                      << (double)allocs / rounds << " per round)\n";
+            steady_allocs += allocs;
+        }
+    }
+
+    // stderr keeps headless result lines intact
+    run_profile.print(std::cerr, robot_names);
+
+    if (steady_allocs > 0) {
+        std::cerr << "Turn loop allocated " << steady_allocs << " times after round 1\n";
         return 1;
     }
-    
-    // Run the game
-    arena.run_game();
-    
     return 0;
 }
+
+// ROWSxCOLS with both halves strict positive ints; false on anything else
+static bool parse_size(const char* text, int& rows, int& cols)
+{
+    const char* x = std::strchr(text, 'x');
+    if (!x) {
+        return false;
+    }
+    std::string row_text(text, x - text);
+    return parse_int(row_text.c_str(), 1, rows) && parse_int(x + 1, 1, cols);
+}
+
+static void print_usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--headless] [--games N] [--threads N] [--round-robin] [--isolate] [--fork] [--jobs N]\n"
+              << "       [--profile debug|release|lto|pgo-generate|pgo-use] [--size ROWSxCOLS] [--tiled] [--copies N]\n"
+              << "       [--seed N] [--first-game N]\n"
+              << "  --headless     no board display, no delays, one result line per game\n"
+              << "  --games N      play N games back to back (default 1)\n"
+              << "  --threads N    run the games as a tournament on N worker threads\n"
+              << "  --round-robin  tournament games pit every pair of robots against each other\n"
+              << "  --isolate      load robots into private dlmopen namespaces so static state\n"
+              << "                 cannot leak between games\n"
+              << "  --fork         tournament forks one child per game from a pre-loaded server\n"
+              << "                 (--threads N sets how many games run at once)\n"
+              << "  --jobs N       compile at most N robots at once (default: one per core)\n"
+              << "  --profile P    robot build profile (default: release)\n"
+              << "  --size RxC     arena size (default: 20x20)\n"
+              << "  --tiled        store the board as sparse tiles (automatic above 2048x2048 cells)\n"
+              << "  --copies N     put N instances of every robot in each game (default 1)\n"
+              << "  --seed N       seed for obstacles, placement and teleports (default: random,\n"
+              << "                 printed so the run can be replayed)\n"
+              << "  --first-game N number the games from N; with the same --seed this replays\n"
+              << "                 game N of an earlier run or tournament\n";
+}
+
+int main(int argc, char* argv[])
+{
+    bool headless = false;
+    int games = 1;
+    int threads = 0;
+    bool isolate = false;
+    bool fork_server = false;
+    int jobs = 0;
+    BuildProfile profile = BuildProfile::release;
+    int rows = STANDARD_ROWS;
+    int cols = STANDARD_COLS;
+    int copies = 1;
+    bool tiled = false;
+    uint64_t seed = 0;
+    bool seeded = false;
+    int first_game = 0;
+    TournamentMode mode = TournamentMode::free_for_all;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--games" && i + 1 < argc && parse_int(argv[i + 1], 1, games)) {
+            i++;
+        } else if (arg == "--threads" && i + 1 < argc && parse_int(argv[i + 1], 1, threads)) {
+            i++;
+        } else if (arg == "--isolate") {
+            isolate = true;
+        } else if (arg == "--jobs" && i + 1 < argc && parse_int(argv[i + 1], 0, jobs)) {
+            i++;
+        } else if (arg == "--profile" && i + 1 < argc && RobotCompiler::parse_profile(argv[i + 1], profile)) {
+            i++;
+        } else if (arg == "--fork") {
+            fork_server = true;
+            threads = std::max(threads, 1);
+        } else if (arg == "--size" && i + 1 < argc && parse_size(argv[i + 1], rows, cols)) {
+            i++;
+        } else if (arg == "--tiled") {
+            tiled = true;
+        } else if (arg == "--copies" && i + 1 < argc && parse_int(argv[i + 1], 1, copies)) {
+            i++;
+        } else if (arg == "--seed" && i + 1 < argc && parse_seed(argv[i + 1], seed)) {
+            i++;
+            seeded = true;
+        } else if (arg == "--first-game" && i + 1 < argc && parse_int(argv[i + 1], 0, first_game)) {
+            i++;
+        } else if (arg == "--round-robin") {
+            mode = TournamentMode::round_robin;
+            threads = std::max(threads, 1);
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Game numbers must stay within int
+    if (first_game > INT_MAX - games) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // Without --seed every run differs; the seed goes to stderr so a game can
+    // be replayed without disturbing headless output
+    if (!seeded) {
+        std::random_device rd;
+        seed = ((uint64_t)rd() << 32) | rd();
+        std::cerr << "Seed: " << seed << "\n";
+    }
+    
+    // Huge arenas only fit in memory as a sparse board
+    if ((long long)rows * cols > TILED_BOARD_CELLS) {
+        tiled = true;
+    }
+
+    if (threads > 0) {
+        // Tournament: robot libraries are loaded once and shared by all worker threads
+        Tournament tournament(rows, cols, mode);
+        tournament.set_isolated(isolate && !fork_server);
+        tournament.set_fork_server(fork_server);
+        tournament.set_copies_per_robot(copies);
+        tournament.set_tiled(tiled);
+        tournament.set_seed(seed);
+        if (!tournament.load_libraries(".", jobs, profile)) {
+            std::cerr << "Failed to load any robots!\n";
+            return 1;
+        }
+        tournament.run(games, threads, first_game);
+        tournament.print_summary();
+        return 0;
+    }
+
+    // Sequential games share one namespace; each game still reloads the libraries
+    // into it, so robot statics start fresh every game
+    NamespacePool namespaces;
+    Lmid_t lmid = LM_ID_BASE;
+    if (isolate && !namespaces.acquire(lmid)) {
+        std::cerr << "Could not create a private namespace for robot libraries\n";
+        return 1;
+    }
+
+    if (tiled) {
+        return play_games<TiledArena>(games, first_game, seed, rows, cols, headless, lmid, copies, jobs, profile);
+    }
+    if (rows == STANDARD_ROWS && cols == STANDARD_COLS) {
+        return play_games<StandardArena>(games, first_game, seed, rows, cols, headless, lmid, copies, jobs, profile);
+    }
+    return play_games<Arena>(games, first_game, seed, rows, cols, headless, lmid, copies, jobs, profile);
+}
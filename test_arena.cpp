@@ -0,0 +1,105 @@
+#include "Arena.h"
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Arena behaviour checks (make check). Each check sets up a small headless
+// arena by hand, plays rounds on it and fails the run if the arena did not do
+// what the rules say.
+
+// ===== TEST ROBOT =====
+
+// Walks one cell right every turn and never shoots
+class WalkerRobot : public RobotBase {
+public:
+    WalkerRobot() : RobotBase(3, 4, railgun) {}
+
+    void get_radar_direction(int& radar_direction) override { radar_direction = 0; }
+    void process_radar_results(const std::vector<RadarObj>&) override {}
+    bool get_shot_location(int&, int&) override { return false; }
+    void get_move_direction(int& direction, int& distance) override { direction = 3; distance = 1; }
+};
+
+// The walker create_walker made last (the arena owns it)
+static RobotBase* g_walker = nullptr;
+
+static RobotBase* create_walker()
+{
+    g_walker = new WalkerRobot();
+    return g_walker;
+}
+
+static bool expect(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+    }
+    return condition;
+}
+
+// ===== CHECKS =====
+
+// A robot that climbs out of a pit gets its speed back and walks on from
+// where it climbed out, instead of being teleported as stuck every turn
+static bool check_escaped_pit()
+{
+    Arena arena(10, 10);
+    arena.set_headless(true);
+    arena.set_seed(1, 0);
+    if (!expect(arena.add_robot(create_walker, "Walker"), "walker added")) {
+        return false;
+    }
+    arena.reserve_turn_buffers();
+    int speed = g_walker->get_move_speed();
+
+    // Start just left of a pit; round 1 walks into it
+    arena.clear_robot_from_board(0);
+    arena.set_robot_location(0, 5, 2);
+    arena.place_robot_on_board(0, 5, 2);
+    arena.place_obstacle(5, 3, PIT);
+    arena.play_round();
+
+    int row, col;
+    g_walker->get_current_location(row, col);
+    bool ok = expect(row == 5 && col == 3 && g_walker->get_move_speed() == 0, "walker trapped in the pit");
+
+    // The fifth round in the pit climbs out to a neighbouring cell
+    for (int round = 0; round < 5; round++) {
+        arena.play_round();
+    }
+    g_walker->get_current_location(row, col);
+    ok &= expect(std::abs(row - 5) <= 1 && std::abs(col - 3) <= 1 && !(row == 5 && col == 3),
+                 "walker climbed out next to the pit");
+    ok &= expect(g_walker->get_move_speed() == speed, "walker speed restored");
+
+    // Then it walks right one cell a round
+    for (int round = 0; round < 3; round++) {
+        arena.play_round();
+        int next_row, next_col;
+        g_walker->get_current_location(next_row, next_col);
+        ok &= expect(next_row == row && next_col == col + 1, "walker walks on after the pit");
+        row = next_row;
+        col = next_col;
+    }
+    return ok;
+}
+
+int main()
+{
+    struct Check {
+        const char* name;
+        bool (*run)();
+    };
+    const Check checks[] = {
+        { "escaped pit", check_escaped_pit },
+    };
+
+    int failed = 0;
+    for (const Check& check : checks) {
+        bool ok = check.run();
+        std::cout << (ok ? "ok      " : "FAILED  ") << check.name << "\n";
+        failed += ok ? 0 : 1;
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -155,8 +155,8 @@ int main(int argc, char* argv[])
     const std::string shared_lib = "lib" + robot_file.substr(0, robot_file.find(".cpp")) + ".so";
 
     // Compile the robot into a shared library -fPIC is Position Independant Code - look it up!
-    // we're also linking a pre-compiled RobotBase.o - problems will arise if there is a mismatch...
-    std::string compile_cmd = "g++ -shared -fPIC -o " + shared_lib + " " + robot_file + " RobotBase.o -I. -std=c++20";
+    // we're also linking the pre-built libRobotBase.so that this tester uses, so both share one RobotBase
+    std::string compile_cmd = "g++ -shared -fPIC -o " + shared_lib + " " + robot_file + " -L. -lRobotBase -I. -std=c++20";
     std::cout << "Compiling " << robot_file << " into " << shared_lib << "...\n";
 
     if (std::system(compile_cmd.c_str()) != 0) {